@@ -0,0 +1,348 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "binarySerializer.hpp"
+#include "mappedFactory.hpp"
+#include "overlayFactory.hpp"
+#include "registrar.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserBenchmarks {
+
+using namespace cppParser;
+
+/**
+ * Documents are sized by their approximate number of yaml nodes.  Every synthetic component is a tagged map holding three scalars.
+ */
+static constexpr std::int64_t nodesPerComponent = 4;
+static constexpr std::int64_t minimumNodes = 10;
+static constexpr std::int64_t maximumNodes = 1000000;
+
+class BenchmarkInterface {
+   public:
+    virtual ~BenchmarkInterface() = default;
+};
+
+class BenchmarkComponent : public BenchmarkInterface {
+   public:
+    const int id;
+    const double value;
+    const std::string name;
+
+    BenchmarkComponent(int id, double value, std::string name) : id(id), value(value), name(std::move(name)) {}
+};
+
+/**
+ * map with a single scalar per key, i.e. key0: 0
+ */
+static std::string FlatMapDocument(std::int64_t nodes) {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    for (std::int64_t i = 0; i < nodes; i++) {
+        yaml << "key" << i << ": " << i << std::endl;
+    }
+    return yaml.str();
+}
+
+/**
+ * a flow sequence of doubles, i.e. coefficients: [0.5, 1.5, ...]
+ */
+static std::string CoefficientDocument(std::int64_t nodes) {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "coefficients: [";
+    for (std::int64_t i = 0; i < nodes; i++) {
+        yaml << (i ? ", " : "") << (i + 0.5) / 3.0;
+    }
+    yaml << "]" << std::endl;
+    return yaml.str();
+}
+
+/**
+ * a components list of tagged maps
+ */
+static std::string ComponentSequenceDocument(std::int64_t nodes) {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "components:" << std::endl;
+    for (std::int64_t i = 0; i < std::max<std::int64_t>(nodes / nodesPerComponent, 1); i++) {
+        yaml << "  - !cppParserBenchmarks::BenchmarkComponent" << std::endl;
+        yaml << "    id: " << i << std::endl;
+        yaml << "    value: " << i * 0.5 << std::endl;
+        yaml << "    name: component" << i << std::endl;
+    }
+    return yaml.str();
+}
+
+/**
+ * a components map of tagged maps
+ */
+static std::string ComponentMapDocument(std::int64_t nodes) {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "components:" << std::endl;
+    for (std::int64_t i = 0; i < std::max<std::int64_t>(nodes / nodesPerComponent, 1); i++) {
+        yaml << "  component" << i << ": !cppParserBenchmarks::BenchmarkComponent" << std::endl;
+        yaml << "    id: " << i << std::endl;
+        yaml << "    value: " << i * 0.5 << std::endl;
+        yaml << "    name: component" << i << std::endl;
+    }
+    return yaml.str();
+}
+
+static void YamlParserConstructionFromString(benchmark::State& state) {
+    const auto document = FlatMapDocument(state.range(0));
+    for (auto _ : state) {
+        auto parser = std::make_shared<YamlParser>(document);
+        benchmark::DoNotOptimize(parser.get());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserConstructionFromString)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserConstructionFromNode(benchmark::State& state) {
+    const auto node = YAML::Load(FlatMapDocument(state.range(0)));
+    for (auto _ : state) {
+        auto parser = std::make_shared<YamlParser>(node);
+        benchmark::DoNotOptimize(parser.get());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserConstructionFromNode)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserConstructionFromFile(benchmark::State& state) {
+    const auto path = std::filesystem::temp_directory_path() / "cppParserBenchmark.yaml";
+    std::ofstream(path) << FlatMapDocument(state.range(0));
+    for (auto _ : state) {
+        auto parser = std::make_shared<YamlParser>(path);
+        benchmark::DoNotOptimize(parser.get());
+    }
+    std::filesystem::remove(path);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserConstructionFromFile)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserLazyGetFromFile(benchmark::State& state) {
+    const auto path = std::filesystem::temp_directory_path() / "cppParserBenchmark.yaml";
+    std::ofstream(path) << ComponentMapDocument(state.range(0));
+    const auto identifier = ArgumentIdentifier<int>{"id", "", false};
+    for (auto _ : state) {
+        // only a single component is used from the document
+        auto parser = std::make_shared<YamlParser>(path, std::map<std::string, std::string>{}, YamlParserOptions{.lazy = true});
+        benchmark::DoNotOptimize(parser->GetFactory("components")->GetFactory("component0")->Get(identifier));
+    }
+    std::filesystem::remove(path);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserLazyGetFromFile)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void MappedFactoryConstructionFromFile(benchmark::State& state) {
+    const auto path = std::filesystem::temp_directory_path() / "cppParserBenchmark.bin";
+    BinarySerializer::Write(YAML::Load(FlatMapDocument(state.range(0))), path);
+    for (auto _ : state) {
+        auto factory = std::make_shared<MappedFactory>(path);
+        benchmark::DoNotOptimize(factory.get());
+    }
+    std::filesystem::remove(path);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(MappedFactoryConstructionFromFile)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void MappedFactoryConstructionFromYamlFile(benchmark::State& state) {
+    const auto path = std::filesystem::temp_directory_path() / "cppParserBenchmark.yaml";
+    std::ofstream(path) << FlatMapDocument(state.range(0));
+    for (auto _ : state) {
+        auto factory = std::make_shared<MappedFactory>(path, MappedFileFormat::Yaml);
+        benchmark::DoNotOptimize(factory.get());
+    }
+    std::filesystem::remove(path);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(MappedFactoryConstructionFromYamlFile)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserOverwriteVariant(benchmark::State& state) {
+    const auto document = FlatMapDocument(state.range(0));
+    const auto overwrites = std::map<std::string, std::string>{{"key0", "-1"}};
+
+    for (auto _ : state) {
+        YamlParser variant(document, {}, overwrites);
+        benchmark::DoNotOptimize(variant.Get(ArgumentIdentifier<int>{"key0", "", false}));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserOverwriteVariant)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void OverlayFactoryVariant(benchmark::State& state) {
+    auto base = std::make_shared<YamlParser>(FlatMapDocument(state.range(0)));
+    const auto overwrites = std::map<std::string, std::string>{{"key0", "-1"}};
+
+    for (auto _ : state) {
+        OverlayFactory variant(base, overwrites);
+        benchmark::DoNotOptimize(variant.Get(ArgumentIdentifier<int>{"key0", "", false}));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(OverlayFactoryVariant)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserGetInt(benchmark::State& state) {
+    YamlParser parser(FlatMapDocument(state.range(0)));
+
+    // the last key is the worst case for a linear scan
+    const auto identifier = ArgumentIdentifier<int>{"key" + std::to_string(state.range(0) - 1), "", false};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.Get(identifier));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserGetInt)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Complexity();
+
+static void YamlParserGetDoubleVector(benchmark::State& state) {
+    YamlParser parser(CoefficientDocument(state.range(0)));
+
+    const auto identifier = ArgumentIdentifier<std::vector<double>>{"coefficients", "", false};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.Get(identifier));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserGetDoubleVector)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserContains(benchmark::State& state) {
+    YamlParser parser(FlatMapDocument(state.range(0)));
+
+    const auto name = "key" + std::to_string(state.range(0) - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.Contains(name));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserContains)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Complexity();
+
+static void YamlParserGetFactorySequence(benchmark::State& state) {
+    const auto node = YAML::Load(ComponentSequenceDocument(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto parser = std::make_shared<YamlParser>(node);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(parser->GetFactorySequence("components"));
+
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserGetFactorySequence)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void YamlParserGetFactorySequenceCached(benchmark::State& state) {
+    YamlParser parser(ComponentSequenceDocument(state.range(0)));
+    parser.GetFactorySequence("components");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parser.GetFactorySequence("components"));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(YamlParserGetFactorySequenceCached)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void CreateInstanceFromFactorySequence(benchmark::State& state) {
+    const auto node = YAML::Load(ComponentSequenceDocument(state.range(0)));
+    const auto identifier = ArgumentIdentifier<std::vector<BenchmarkInterface>>{"components", "", false};
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto parser = std::make_shared<YamlParser>(node);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(parser->Get(identifier));
+
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(CreateInstanceFromFactorySequence)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void CreateInstanceFromFactorySequenceParallel(benchmark::State& state) {
+    const auto node = YAML::Load(ComponentSequenceDocument(state.range(0)));
+    const auto identifier = ArgumentIdentifier<std::vector<BenchmarkInterface>>{"components", "", false};
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto parser = std::make_shared<YamlParser>(node, std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.parallel = true});
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(parser->Get(identifier));
+
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(CreateInstanceFromFactorySequenceParallel)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity()->UseRealTime();
+
+static void CreateInstanceFromFactoryMap(benchmark::State& state) {
+    const auto node = YAML::Load(ComponentMapDocument(state.range(0)));
+    const auto identifier = ArgumentIdentifier<std::map<std::string, BenchmarkInterface>>{"components", "", false};
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto parser = std::make_shared<YamlParser>(node);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(parser->Get(identifier));
+
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(CreateInstanceFromFactoryMap)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void CreateInstanceFromFactoryOrderedMap(benchmark::State& state) {
+    const auto node = YAML::Load(ComponentMapDocument(state.range(0)));
+    const auto identifier = ArgumentIdentifier<OrderedMap<std::string, BenchmarkInterface>>{"components", "", false};
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto parser = std::make_shared<YamlParser>(node);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(parser->Get(identifier));
+
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(CreateInstanceFromFactoryOrderedMap)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void InstanceTrackerGetInstance(benchmark::State& state) {
+    YamlParser parser(ComponentSequenceDocument(state.range(0)));
+    auto factories = parser.GetFactorySequence("components");
+
+    // every factory shares the same class type, so they all land in a single bucket
+    InstanceTracker instanceTracker;
+    for (const auto& factory : factories) {
+        instanceTracker.SetInstance<BenchmarkInterface>(factory, std::make_shared<BenchmarkComponent>(0, 0.0, ""));
+    }
+
+    const auto& lastFactory = factories.back();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(instanceTracker.GetInstance<BenchmarkInterface>(lastFactory));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(InstanceTrackerGetInstance)->RangeMultiplier(10)->Range(minimumNodes, maximumNodes)->Complexity();
+
+}  // namespace cppParserBenchmarks
+
+REGISTER(cppParserBenchmarks::BenchmarkInterface, cppParserBenchmarks::BenchmarkComponent, "synthetic component used to benchmark instantiation", ARG(int, "id", "the component id"),
+         ARG(double, "value", "a scalar value"), OPT(std::string, "name", "an optional name"));
+
+BENCHMARK_MAIN();
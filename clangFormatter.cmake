@@ -21,6 +21,7 @@ if(CLANG_FORMAT AND Python_Interpreter_FOUND)
             --extensions=cpp,hpp,cc,hh,c++,h++,cxx,hxx
             ${PROJECT_SOURCE_DIR}/src
             ${PROJECT_SOURCE_DIR}/tests
+            ${PROJECT_SOURCE_DIR}/benchmarks
             WORKING_DIRECTORY ${PROJECT_SOURCE_DIR}
             USES_TERMINAL
     )
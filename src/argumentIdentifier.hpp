@@ -1,5 +1,6 @@
 #ifndef CPPPARSER_ARGUMENTIDENTIFIER_HPP
 #define CPPPARSER_ARGUMENTIDENTIFIER_HPP
+#include <functional>
 #include <optional>
 #include <string>
 #include "enumWrapper.hpp"
@@ -21,6 +22,8 @@ struct ArgumentIdentifier {
     const std::string inputName;
     const std::string description = "";
     const bool optional = false;
+    // the hash of the inputName is computed once so that lookups by the factory do not need to rehash the name
+    const std::size_t inputNameHash = std::hash<std::string>{}(inputName);
     bool operator==(const ArgumentIdentifier<Interface>& other) const { return inputName == other.inputName && optional == other.optional; }
 };
 
@@ -0,0 +1,14 @@
+#include "arrayFiles.hpp"
+
+std::shared_ptr<const cppParser::MappedFile> cppParser::ArrayFiles::Map(const std::filesystem::path& path) {
+    if (!std::filesystem::is_regular_file(path)) {
+        throw std::invalid_argument("unable to locate array file " + path.string());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& file = files[std::filesystem::canonical(path)];
+    if (!file) {
+        file = std::make_shared<const MappedFile>(path);
+    }
+    return file;
+}
@@ -0,0 +1,46 @@
+#ifndef CPPPARSER_ARRAYFILES_HPP
+#define CPPPARSER_ARRAYFILES_HPP
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include "arrayView.hpp"
+#include "mappedFile.hpp"
+
+namespace cppParser {
+
+/**
+ * The binary array files referenced from a document, i.e. "coefficients: !array data/coeffs.f64".  An array file holds only the raw values in the native byte order.  Each file
+ * is memory mapped once and shared by every view into it.
+ */
+class ArrayFiles {
+   private:
+    std::mutex mutex;
+    std::map<std::filesystem::path, std::shared_ptr<const MappedFile>> files;
+
+    /**
+     * Map the file or return the existing mapping
+     */
+    std::shared_ptr<const MappedFile> Map(const std::filesystem::path& path);
+
+   public:
+    /**
+     * View the file as an array of values
+     * @tparam T
+     * @param path
+     * @return
+     */
+    template <typename T>
+    ArrayView<T> GetView(const std::filesystem::path& path) {
+        auto file = Map(path);
+        if (file->GetSize() % sizeof(T) != 0) {
+            throw std::invalid_argument("the size of array file " + path.string() + " is not a multiple of " + std::to_string(sizeof(T)) + " bytes");
+        }
+        return ArrayView<T>(file, reinterpret_cast<const T*>(file->GetData()), file->GetSize() / sizeof(T));
+    }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_ARRAYFILES_HPP
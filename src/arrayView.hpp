@@ -0,0 +1,65 @@
+#ifndef CPPPARSER_ARRAYVIEW_HPP
+#define CPPPARSER_ARRAYVIEW_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+namespace cppParser {
+
+/**
+ * A read only, contiguous view of values that keeps the memory behind the values alive, i.e. a memory mapped array file or a vector owned by the view.  Converts to a
+ * std::span<const T> when compiled with C++20.
+ */
+template <typename T>
+class ArrayView {
+   private:
+    std::shared_ptr<const void> owner;
+    const T* values = nullptr;
+    std::size_t count = 0;
+
+   public:
+    ArrayView() = default;
+
+    /**
+     * View values that are kept alive by the owner
+     * @param owner
+     * @param values
+     * @param count
+     */
+    ArrayView(std::shared_ptr<const void> owner, const T* values, std::size_t count) : owner(std::move(owner)), values(values), count(count) {}
+
+    /**
+     * Take ownership of the values
+     * @param vector
+     */
+    explicit ArrayView(std::vector<T> vector) {
+        auto ownedValues = std::make_shared<const std::vector<T>>(std::move(vector));
+        values = ownedValues->data();
+        count = ownedValues->size();
+        owner = std::move(ownedValues);
+    }
+
+    [[nodiscard]] inline const T* data() const { return values; }
+
+    [[nodiscard]] inline std::size_t size() const { return count; }
+
+    [[nodiscard]] inline bool empty() const { return count == 0; }
+
+    inline const T& operator[](std::size_t i) const { return values[i]; }
+
+    inline const T* begin() const { return values; }
+
+    inline const T* end() const { return values + count; }
+
+#if defined(__cpp_lib_span)
+    operator std::span<const T>() const { return {values, count}; }
+#endif
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_ARRAYVIEW_HPP
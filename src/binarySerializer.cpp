@@ -0,0 +1,132 @@
+#include "binarySerializer.hpp"
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+/**
+ * Builds the flat arrays from a yaml node
+ */
+class FlatDocumentBuilder {
+   private:
+    std::vector<cppParser::FlatNode> nodes;
+    std::vector<cppParser::FlatEntry> entries;
+    std::string strings;
+
+    // each string is only stored once
+    std::unordered_map<std::string, std::uint32_t> stringOffsets;
+
+    // nodes that have already been added, grouped by their position in the source so that anchors/aliases are stored once
+    std::unordered_map<std::size_t, std::vector<std::pair<YAML::Node, std::uint32_t>>> addedNodes;
+
+    std::uint32_t AddString(const std::string& value) {
+        if (value.empty()) {
+            return 0;
+        }
+        if (auto it = stringOffsets.find(value); it != stringOffsets.end()) {
+            return it->second;
+        }
+        if (strings.size() + value.size() > cppParser::arenaOffsetFlag) {
+            throw std::invalid_argument("the strings are too large to store in a binary config file");
+        }
+        auto offset = (std::uint32_t)strings.size();
+        strings.append(value);
+        stringOffsets.emplace(value, offset);
+        return offset;
+    }
+
+   public:
+    std::uint32_t AddNode(const YAML::Node& node) {
+        // check if this node has already been added through an anchor
+        const auto& mark = node.Mark();
+        if (!mark.is_null()) {
+            for (const auto& [addedNode, index] : addedNodes[mark.pos]) {
+                if (addedNode.is(node)) {
+                    return index;
+                }
+            }
+        }
+
+        auto index = (std::uint32_t)nodes.size();
+        nodes.push_back(cppParser::FlatNode{});
+        if (!mark.is_null()) {
+            addedNodes[mark.pos].emplace_back(node, index);
+        }
+
+        cppParser::FlatNode flatNode{};
+        if (!mark.is_null()) {
+            flatNode.line = (std::uint32_t)mark.line;
+            flatNode.column = (std::uint32_t)mark.column;
+        }
+        const auto& tag = node.Tag();
+        flatNode.tagOffset = AddString(tag);
+        flatNode.tagLength = (std::uint32_t)tag.size();
+
+        // children are added before this node's entries so that the entries are contiguous
+        std::vector<cppParser::FlatEntry> nodeEntries;
+        switch (node.Type()) {
+            case YAML::NodeType::Scalar:
+                flatNode.type = cppParser::FlatNodeType::Scalar;
+                flatNode.scalarOffset = AddString(node.Scalar());
+                flatNode.scalarLength = (std::uint32_t)node.Scalar().size();
+                break;
+            case YAML::NodeType::Sequence:
+                flatNode.type = cppParser::FlatNodeType::Sequence;
+                for (const auto& child : node) {
+                    nodeEntries.push_back(cppParser::FlatEntry{.keyOffset = 0, .keyLength = 0, .node = AddNode(child)});
+                }
+                break;
+            case YAML::NodeType::Map:
+                flatNode.type = cppParser::FlatNodeType::Map;
+                for (const auto& child : node) {
+                    if (!child.first.IsScalar()) {
+                        throw std::invalid_argument("only scalar keys can be stored in a binary config file");
+                    }
+                    const auto& key = child.first.Scalar();
+                    nodeEntries.push_back(cppParser::FlatEntry{.keyOffset = AddString(key), .keyLength = (std::uint32_t)key.size(), .node = AddNode(child.second)});
+                }
+                break;
+            default:
+                flatNode.type = cppParser::FlatNodeType::Null;
+        }
+
+        flatNode.firstEntry = (std::uint32_t)entries.size();
+        flatNode.entryCount = (std::uint32_t)nodeEntries.size();
+        entries.insert(entries.end(), nodeEntries.begin(), nodeEntries.end());
+        nodes[index] = flatNode;
+        return index;
+    }
+
+    void Write(std::uint32_t root, std::ostream& stream) const {
+        cppParser::FlatHeader header{};
+        std::memcpy(header.magic, cppParser::FlatHeader::expectedMagic, sizeof(header.magic));
+        header.version = cppParser::FlatHeader::expectedVersion;
+        header.endianCheck = cppParser::FlatHeader::expectedEndianCheck;
+        header.root = root;
+        header.nodeCount = nodes.size();
+        header.entryCount = entries.size();
+        header.stringsSize = strings.size();
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(nodes.data()), (std::streamsize)(nodes.size() * sizeof(cppParser::FlatNode)));
+        stream.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(cppParser::FlatEntry)));
+        stream.write(strings.data(), (std::streamsize)strings.size());
+    }
+};
+}  // namespace
+
+void cppParser::BinarySerializer::Write(const YAML::Node& node, std::ostream& stream) {
+    FlatDocumentBuilder builder;
+    auto root = builder.AddNode(node);
+    builder.Write(root, stream);
+}
+
+void cppParser::BinarySerializer::Write(const YAML::Node& node, const std::filesystem::path& path) {
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream) {
+        throw std::invalid_argument("unable to write " + path.string());
+    }
+    Write(node, stream);
+}
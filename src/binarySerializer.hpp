@@ -0,0 +1,35 @@
+#ifndef CPPPARSER_BINARYSERIALIZER_HPP
+#define CPPPARSER_BINARYSERIALIZER_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <filesystem>
+#include <ostream>
+#include "flatDocument.hpp"
+
+namespace cppParser {
+
+/**
+ * Writes a yaml document as a binary config file that can be memory mapped by the MappedFactory.  Tags, scalars, sequences, and maps are kept and anchors are resolved so that
+ * each aliased node is stored once.
+ */
+class BinarySerializer {
+   public:
+    BinarySerializer() = delete;
+
+    /**
+     * Write the node to the stream
+     * @param node
+     * @param stream
+     */
+    static void Write(const YAML::Node& node, std::ostream& stream);
+
+    /**
+     * Write the node to the file
+     * @param node
+     * @param path
+     */
+    static void Write(const YAML::Node& node, const std::filesystem::path& path);
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_BINARYSERIALIZER_HPP
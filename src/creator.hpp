@@ -1,11 +1,19 @@
 #ifndef CPPPARSER_CREATOR_HPP
 #define CPPPARSER_CREATOR_HPP
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "argumentIdentifier.hpp"
 #include "demangler.hpp"
 #include "listing.hpp"
@@ -13,12 +21,48 @@
 namespace cppParser {
 
 class Factory;
+class InstancePlan;
 
 /**
  * Use this symbol to mark that a derived class is default
  */
 static inline std::string DerivedSymbol = "->";
 
+/**
+ * Incremented by every registration so that cached create methods are invalidated.  A derived registration changes the lookup of every base interface, so a single epoch
+ * is shared by all interfaces for the resolved lookups.  The frozen tables only hold direct registrations and use the epoch of their own interface.
+ */
+inline std::atomic<std::size_t> registrationEpoch = 0;
+
+/**
+ * The freeze method of every interface with registrations.  Interfaces may be first used from several threads, so the list is locked.
+ */
+struct FreezeMethods {
+    std::mutex mutex;
+    std::vector<void (*)()> methods;
+};
+
+inline FreezeMethods& GetFreezeMethods() {
+    static auto freezeMethods = new FreezeMethods();
+    return *freezeMethods;
+}
+
+/**
+ * Compact the registrations of every interface into read-only tables.  This is done automatically for each interface the first time an instance is created from a factory.
+ */
+inline void FreezeRegistrations() {
+    // copy the methods so that interfaces first used while freezing can record their own freeze method
+    std::vector<void (*)()> methods;
+    {
+        auto& freezeMethods = GetFreezeMethods();
+        std::lock_guard lock(freezeMethods.mutex);
+        methods = freezeMethods.methods;
+    }
+    for (auto freezeMethod : methods) {
+        freezeMethod();
+    }
+}
+
 template <typename Interface>
 class Creator {
    public:
@@ -26,12 +70,25 @@ class Creator {
 
     using TCreateMethod = std::function<std::shared_ptr<Interface>(std::shared_ptr<Factory>)>;
 
+    /**
+     * adds the arguments used to create the class from the factory to the plan as dependencies of the node
+     */
+    using TPlanMethod = std::function<void(const std::shared_ptr<Factory>& factory, InstancePlan& plan, std::size_t node)>;
+
     /**
      * static map of construction methods for this interface
      * @return
      */
     static std::map<std::string, TCreateMethod>& GetConstructionMethods() {
         static auto methods = new std::map<std::string, TCreateMethod>();
+
+        // record the freeze method the first time this interface is used
+        [[maybe_unused]] static const bool freezeMethodRecorded = [] {
+            auto& freezeMethods = GetFreezeMethods();
+            std::lock_guard lock(freezeMethods.mutex);
+            freezeMethods.methods.push_back(&Freeze);
+            return true;
+        }();
         return *methods;
     }
 
@@ -44,17 +101,117 @@ class Creator {
         return *methods;
     }
 
+    /**
+     * static map of plan methods for this interface.  Only classes registered with argument identifiers can be planned.
+     * @return
+     */
+    static std::map<std::string, TPlanMethod>& GetPlanMethods() {
+        static auto methods = new std::map<std::string, TPlanMethod>();
+        return *methods;
+    }
+
+    /**
+     * static map of plan methods for classes/interfaces that inherit from this
+     * @return
+     */
+    static std::map<std::string, std::function<TPlanMethod(const std::string&)>>& GetDerivedPlanMethods() {
+        static auto methods = new std::map<std::string, std::function<TPlanMethod(const std::string&)>>();
+        return *methods;
+    }
+
     static std::string& GetDefaultClassName() {
         static auto defaultClassName = new std::string();
         return *defaultClassName;
     };
 
+    /**
+     * Incremented by every registration with this interface, so that only the frozen table of this interface is rebuilt
+     */
+    static std::atomic<std::size_t>& GetRegistrationEpoch() {
+        static std::atomic<std::size_t> epoch = 0;
+        return epoch;
+    }
+
+    /**
+     * Invalidate the frozen table of this interface and every cached create method.  Called as the last write of a registration.
+     */
+    static void InvalidateCreateMethods() {
+        registrationEpoch++;
+        GetRegistrationEpoch()++;
+    }
+
+   private:
+    /**
+     * A slot in the frozen table.  Entries only point into the owning table, so they are trivially copyable.
+     */
+    struct FrozenEntry {
+        std::size_t hash;
+        const std::string* className;
+        const TCreateMethod* createMethod;
+    };
+    static_assert(std::is_trivially_copyable_v<FrozenEntry>);
+
+    /**
+     * A read-only perfect hash table of the create methods registered with this interface (plus the default for an empty class name when it is registered directly)
+     */
+    struct FrozenTable {
+        std::size_t epoch = 0;
+        std::size_t seed = 0;
+        std::size_t mask = 0;
+        std::vector<std::string> classNames;
+        std::vector<TCreateMethod> createMethods;
+        std::vector<FrozenEntry> slots;
+
+        inline std::size_t Slot(std::size_t hash) const { return MixHash(hash ^ seed) & mask; }
+    };
+
+    /**
+     * The current table, only read and written with std::atomic_load and std::atomic_store.  A table replaced after a late registration is freed once the last thread
+     * holding a snapshot of it moves on.
+     */
+    static std::shared_ptr<const FrozenTable>& GetFrozenTable() {
+        static auto table = new std::shared_ptr<const FrozenTable>();
+        return *table;
+    }
+
+    /**
+     * The address of the current table, so that a thread can check its snapshot without locking.  It is only compared, never dereferenced.
+     */
+    static std::atomic<const FrozenTable*>& GetFrozenTableAddress() {
+        static std::atomic<const FrozenTable*> address = nullptr;
+        return address;
+    }
+
+    static inline std::size_t MixHash(std::size_t value) {
+        // the splitmix64 finalizer
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111eb;
+        value ^= value >> 31;
+        return value;
+    }
+
+    /**
+     * The resolved create method (including misses) for each class name.  The cache is only valid for the registrationEpoch it was built in.
+     */
+    struct CreateMethodCache {
+        std::shared_mutex mutex;
+        std::size_t epoch = 0;
+        std::unordered_map<std::string, TCreateMethod> methods;
+    };
+
+    static CreateMethodCache& GetCreateMethodCache() {
+        static auto cache = new CreateMethodCache();
+        return *cache;
+    }
+
     /**
      * check this and inherited class creator methods
      * @param className
      * @return
      */
-    static TCreateMethod GetCreateMethod(const std::string& className) {
+    static TCreateMethod FindCreateMethod(const std::string& className) {
         std::map<std::string, TCreateMethod>& methods = GetConstructionMethods();
         if (className.empty()) {
             const auto& defaultClassName = Creator<Interface>::GetDefaultClassName();
@@ -75,6 +232,161 @@ class Creator {
             }
         }
 
+        return nullptr;
+    }
+
+   public:
+    /**
+     * Compact the registrations of this interface into a read-only perfect hash table.  Registering after the freeze causes the table to be rebuilt on the next lookup.
+     */
+    static void Freeze() {
+        static std::mutex freezeMutex;
+        std::lock_guard lock(freezeMutex);
+
+        const auto epoch = GetRegistrationEpoch().load();
+        if (auto current = std::atomic_load(&GetFrozenTable()); current && current->epoch == epoch) {
+            return;
+        }
+
+        auto table = std::make_shared<FrozenTable>();
+        table->epoch = epoch;
+
+        // copy each registration (and a directly registered default) into the table so that the entries stay valid.  A default from a derived interface depends on the
+        // registrations of that interface and is resolved by GetCreateMethod.
+        const auto& methods = GetConstructionMethods();
+        for (const auto& [className, createMethod] : methods) {
+            table->classNames.push_back(className);
+            table->createMethods.push_back(createMethod);
+        }
+        if (auto defaultMethod = methods.find(GetDefaultClassName()); defaultMethod != methods.end()) {
+            table->classNames.emplace_back();
+            table->createMethods.push_back(defaultMethod->second);
+        }
+
+        // search for a seed that places every class name in a unique slot, growing the table when no seed is found.  Names with identical hashes cannot be separated by
+        // a seed so only the first is placed in the table, the others are found by GetCreateMethod.
+        std::vector<std::size_t> hashes;
+        std::vector<std::size_t> indices;
+        std::unordered_set<std::size_t> uniqueHashes;
+        for (std::size_t i = 0; i < table->classNames.size(); i++) {
+            auto hash = std::hash<std::string_view>{}(table->classNames[i]);
+            if (uniqueHashes.insert(hash).second) {
+                hashes.push_back(hash);
+                indices.push_back(i);
+            }
+        }
+        std::size_t size = 1;
+        while (size < 2 * hashes.size()) {
+            size *= 2;
+        }
+        while (true) {
+            table->mask = size - 1;
+            for (std::size_t attempt = 0; attempt < 32; attempt++) {
+                table->seed = MixHash(attempt + 1);
+                table->slots.assign(size, FrozenEntry{.hash = 0, .className = nullptr, .createMethod = nullptr});
+                bool collision = false;
+                for (std::size_t i = 0; i < hashes.size() && !collision; i++) {
+                    auto& slot = table->slots[table->Slot(hashes[i])];
+                    collision = slot.createMethod != nullptr;
+                    slot = FrozenEntry{.hash = hashes[i], .className = &table->classNames[indices[i]], .createMethod = &table->createMethods[indices[i]]};
+                }
+                if (!collision) {
+                    std::atomic_store(&GetFrozenTable(), std::shared_ptr<const FrozenTable>(table));
+                    GetFrozenTableAddress().store(table.get(), std::memory_order_release);
+                    return;
+                }
+            }
+            size *= 2;
+        }
+    }
+
+    /**
+     * Look up the class name in the frozen table, freezing the registrations first if needed.  Each thread keeps a snapshot of the table, so this does not lock or allocate
+     * once the table is built.
+     * @param className
+     * @return the create method, which keeps its table alive, or nullptr when the class name is not registered directly with this interface
+     */
+    static std::shared_ptr<const TCreateMethod> GetFrozenCreateMethod(const std::string& className) {
+        static thread_local std::shared_ptr<const FrozenTable> snapshot;
+        if (!snapshot || snapshot.get() != GetFrozenTableAddress().load(std::memory_order_acquire) ||
+            snapshot->epoch != GetRegistrationEpoch().load(std::memory_order_relaxed)) {
+            auto table = std::atomic_load(&GetFrozenTable());
+            if (!table || table->epoch != GetRegistrationEpoch().load()) {
+                Freeze();
+                table = std::atomic_load(&GetFrozenTable());
+            }
+            snapshot = std::move(table);
+        }
+
+        const auto hash = std::hash<std::string_view>{}(className);
+        const auto& slot = snapshot->slots[snapshot->Slot(hash)];
+        if (slot.createMethod && slot.hash == hash && *slot.className == className) {
+            // share ownership with the table so the method stays valid if this thread replaces its snapshot while creating
+            return std::shared_ptr<const TCreateMethod>(snapshot, slot.createMethod);
+        }
+        return nullptr;
+    }
+
+    /**
+     * check this and inherited class creator methods.  The result is cached until the next registration.
+     * @param className
+     * @return
+     */
+    static TCreateMethod GetCreateMethod(const std::string& className) {
+        if (auto frozenCreateMethod = GetFrozenCreateMethod(className)) {
+            return *frozenCreateMethod;
+        }
+
+        auto& cache = GetCreateMethodCache();
+        const auto epoch = registrationEpoch.load();
+        {
+            std::shared_lock lock(cache.mutex);
+            if (cache.epoch == epoch) {
+                if (auto it = cache.methods.find(className); it != cache.methods.end()) return it->second;
+            }
+        }
+
+        auto method = FindCreateMethod(className);
+        {
+            std::unique_lock lock(cache.mutex);
+            if (cache.epoch < epoch) {
+                cache.methods.clear();
+                cache.epoch = epoch;
+            }
+            // a result from an older epoch may be out of date and is not stored
+            if (cache.epoch == epoch) {
+                cache.methods.try_emplace(className, method);
+            }
+        }
+        return method;
+    }
+
+    /**
+     * check this and inherited class plan methods, the lookup matches GetCreateMethod
+     * @param className
+     * @return
+     */
+    static TPlanMethod GetPlanMethod(const std::string& className) {
+        std::map<std::string, TPlanMethod>& methods = GetPlanMethods();
+        if (className.empty()) {
+            const auto& defaultClassName = Creator<Interface>::GetDefaultClassName();
+            if (auto it = methods.find(defaultClassName); it != methods.end()) return it->second;
+
+            // Also check th derived classes
+            const auto& derivedPlanMethods = GetDerivedPlanMethods();
+            if (auto it = derivedPlanMethods.find(DerivedSymbol + defaultClassName); it != derivedPlanMethods.end()) return it->second(className);
+        }
+        // Now check each method for the class name
+        if (auto it = methods.find(className); it != methods.end()) return it->second;
+
+        // check each of the derivedPlanMethods
+        for (auto& [derivedClassName, derivedPlanMethod] : GetDerivedPlanMethods()) {
+            auto testResult = derivedPlanMethod(className);
+            if (testResult != nullptr) {
+                return testResult;
+            }
+        }
+
         return nullptr;
     }
 };
@@ -6,8 +6,9 @@
 
 std::string cppParser::Demangler::Demangle(const std::string& name) {
     // hard code some default values
-    if (prettyNames.count(name) != 0) {
-        return prettyNames[name];
+    const auto& prettyNames = GetPrettyNames();
+    if (auto prettyName = prettyNames.find(name); prettyName != prettyNames.end()) {
+        return std::string(prettyName->second);
     }
 
     int status = -4;  // some arbitrary value to eliminate the compiler warning
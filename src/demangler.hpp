@@ -6,9 +6,16 @@
 #include <numeric>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
+#include "arrayView.hpp"
 #include "enumWrapper.hpp"
+#include "matrix.hpp"
+#include "orderedMap.hpp"
 
 namespace cppParser {
 class Demangler {
@@ -33,7 +40,92 @@ class Demangler {
         if (IsSpecialization<T, cppParser::EnumWrapper>::value) {
             return TypeInfo<T, cppParser::EnumWrapper>::GetTypeName() + " enum";
         }
-        return Demangle(typeid(T).name());
+        return std::string(DemangleType<T>());
+    }
+
+    /**
+     * A type with a hard coded name
+     */
+    template <class T>
+    struct PrettyNamedType {
+        using Type = T;
+        std::string_view name;
+    };
+
+    /**
+     * The hard coded names, used for both the compile time and runtime lookups
+     */
+    static constexpr auto prettyNamedTypes = std::make_tuple(PrettyNamedType<std::string>{"string"},
+                                                             PrettyNamedType<std::map<std::string, std::string>>{"argument map"},
+                                                             PrettyNamedType<std::vector<int>>{"int list"},
+                                                             PrettyNamedType<std::vector<double>>{"double list"},
+                                                             PrettyNamedType<std::vector<std::string>>{"string list"},
+                                                             PrettyNamedType<std::filesystem::path>{"file path or url"},
+                                                             PrettyNamedType<Matrix<int>>{"int matrix"},
+                                                             PrettyNamedType<Matrix<double>>{"double matrix"},
+                                                             PrettyNamedType<Matrix<std::string>>{"string matrix"},
+                                                             PrettyNamedType<ArrayView<int>>{"int array"},
+                                                             PrettyNamedType<ArrayView<double>>{"double array"});
+
+    /**
+     * The hard coded name of the type, empty when there is none
+     */
+    template <class T>
+    static constexpr std::string_view PrettyName() {
+        return std::apply(
+            [](auto... prettyNamedType) {
+                std::string_view name;
+                ((name = std::is_same_v<typename decltype(prettyNamedType)::Type, T> ? prettyNamedType.name : name), ...);
+                return name;
+            },
+            prettyNamedTypes);
+    }
+
+    template <class T>
+    static constexpr bool HasPrettyName() {
+        return !PrettyName<T>().empty();
+    }
+
+    /**
+     * The hard coded names by runtime type name
+     */
+    static const std::unordered_map<std::string, std::string_view>& GetPrettyNames() {
+        static const auto prettyNames = std::apply(
+            [](auto... prettyNamedType) {
+                return std::unordered_map<std::string, std::string_view>{{typeid(typename decltype(prettyNamedType)::Type).name(), prettyNamedType.name}...};
+            },
+            prettyNamedTypes);
+        return prettyNames;
+    }
+
+    /**
+     * The compile time name is only used when it matches the runtime demangled name.  Templates, anonymous namespaces, local classes, and fundamental types (i.e. long int vs
+     * long) can be printed differently, so they use the runtime path.
+     */
+    template <class T>
+    static constexpr bool HasCompileTimeName() {
+        if constexpr ((std::is_class_v<T> || std::is_enum_v<T>) && !HasPrettyName<T>()) {
+            constexpr auto name = TypeName<T>();
+            return !name.empty() && name.find_first_of("<>(){} ") == std::string_view::npos;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * return the name of a single type, using the hard coded or compile time name when available
+     */
+    template <class T>
+    inline static std::string_view DemangleType() {
+        if constexpr (HasPrettyName<T>()) {
+            return PrettyName<T>();
+        } else if constexpr (HasCompileTimeName<T>()) {
+            return TypeName<T>();
+        } else {
+            // the runtime name is computed once for each type
+            static const std::string name = Demangle(typeid(T).name());
+            return name;
+        }
     }
 
     template <typename Test, template <typename...> class Ref>
@@ -56,32 +148,52 @@ class Demangler {
     };
 
    public:
+    /**
+     * The name of the type parsed from the compiler's pretty function name at compile time.  The name is empty when not supported by the compiler.
+     * @tparam T
+     * @return
+     */
     template <class T>
-    inline static std::string Demangle() {
-        if constexpr (IsSpecialization<T, std::vector>::value) {
-            return TypeInfo<T, std::vector>::GetTypeName() + " list";
-        }
-
-        if constexpr (IsSpecialization<T, std::map>::value) {
-            return TypeInfo<T, std::map>::GetTypeName() + " map";
+    static constexpr std::string_view TypeName() {
+#if defined(__clang__) || defined(__GNUC__)
+        // i.e. "... TypeName() [T = Type]" (clang) or "... TypeName() [with T = Type; ...]" (gcc)
+        constexpr std::string_view function = __PRETTY_FUNCTION__;
+        constexpr std::string_view prefix = "T = ";
+        constexpr auto start = function.find(prefix);
+        if constexpr (start == std::string_view::npos) {
+            return {};
+        } else {
+            constexpr auto name = function.substr(start + prefix.size());
+            return name.substr(0, name.find_first_of(";]"));
         }
+#else
+        return {};
+#endif
+    }
 
-        if constexpr (IsSpecialization<T, cppParser::EnumWrapper>::value) {
-            return TypeInfo<T, cppParser::EnumWrapper>::GetTypeName() + " enum";
+    /**
+     * The name of the type for listings and error messages.  The name is built at most once for each type, so the view stays valid for the life of the program.
+     * @tparam T
+     * @return
+     */
+    template <class T>
+    inline static std::string_view Demangle() {
+        if constexpr (IsSpecialization<T, std::vector>::value) {
+            static const std::string name = TypeInfo<T, std::vector>::GetTypeName() + " list";
+            return name;
+        } else if constexpr (IsSpecialization<T, std::map>::value) {
+            static const std::string name = TypeInfo<T, std::map>::GetTypeName() + " map";
+            return name;
+        } else if constexpr (IsSpecialization<T, cppParser::OrderedMap>::value) {
+            static const std::string name = TypeInfo<T, cppParser::OrderedMap>::GetTypeName() + " map";
+            return name;
+        } else if constexpr (IsSpecialization<T, cppParser::EnumWrapper>::value) {
+            static const std::string name = TypeInfo<T, cppParser::EnumWrapper>::GetTypeName() + " enum";
+            return name;
+        } else {
+            return DemangleType<T>();
         }
-
-        return Demangle(typeid(T).name());
     }
-
-   private:
-    inline static std::map<std::string, std::string> prettyNames = {
-        {typeid(std::string).name(), "string"},
-        {typeid(std::map<std::string, std::string>).name(), "argument map"},
-        {typeid(std::vector<int>).name(), "int list"},
-        {typeid(std::vector<double>).name(), "double list"},
-        {typeid(std::vector<std::string>).name(), "string list"},
-        {typeid(std::filesystem::path).name(), "file path or url"},
-    };
 };
 }  // namespace cppParser
 
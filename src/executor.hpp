@@ -0,0 +1,23 @@
+#ifndef CPPPARSER_EXECUTOR_HPP
+#define CPPPARSER_EXECUTOR_HPP
+
+#include <functional>
+#include <vector>
+
+namespace cppParser {
+/**
+ * The executor class is used by the factory to run independent construction tasks (i.e. the elements of a sequence or map) in parallel
+ */
+class Executor {
+   public:
+    /**
+     * Run each of the tasks and return once all of them are complete.  The calling thread may be used to run tasks.  If any task throws, the first exception is rethrown after all
+     * tasks are complete.
+     * @param tasks
+     */
+    virtual void Run(std::vector<std::function<void()>> tasks) = 0;
+    virtual ~Executor() = default;
+};
+}  // namespace cppParser
+
+#endif  // CPPPARSER_EXECUTOR_HPP
@@ -4,27 +4,46 @@
 #include <filesystem>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 #include "argumentIdentifier.hpp"
+#include "arrayView.hpp"
 #include "creator.hpp"
+#include "executor.hpp"
 #include "instanceTracker.hpp"
+#include "matrix.hpp"
+#include "orderedMap.hpp"
 #include "pathLocator.hpp"
 
 namespace cppParser {
 
 class Factory {
+    // the plan creates instances directly from the factories
+    friend class InstancePlan;
+
+    // overlays share the instance tracker and usages of the factory they overwrite
+    friend class OverlayFactory;
+
    protected:
     mutable std::weak_ptr<InstanceTracker> instanceTracker;
 
+    // when set, the elements of sequences and maps are created in parallel using the executor
+    const std::shared_ptr<Executor> executor;
+
    public:
-    explicit Factory(std::weak_ptr<InstanceTracker> instanceTracker = {}) : instanceTracker(std::move(instanceTracker)) {}
+    explicit Factory(std::weak_ptr<InstanceTracker> instanceTracker = {}, std::shared_ptr<Executor> executor = {})
+        : instanceTracker(std::move(instanceTracker)), executor(std::move(executor)) {}
     virtual ~Factory() = default;
 
+    /* the tracker used to reuse instances created from the same factory, nullptr when instances are not tracked */
+    [[nodiscard]] std::shared_ptr<InstanceTracker> GetInstanceTracker() const { return instanceTracker.lock(); }
+
     /* return a factory that serves as the root of the requested item */
     virtual std::shared_ptr<Factory> GetFactory(const std::string& name) const = 0;
 
@@ -66,14 +85,107 @@ class Factory {
     /* return a map of strings */
     virtual std::map<std::string, std::string> Get(const ArgumentIdentifier<std::map<std::string, std::string>>& identifier) const = 0;
 
+    /* return a row-major matrix of int, by default copied from the vector of vectors */
+    virtual Matrix<int> Get(const ArgumentIdentifier<Matrix<int>>& identifier) const {
+        return Matrix<int>(Get(ArgumentIdentifier<std::vector<std::vector<int>>>{.inputName = identifier.inputName, .description = identifier.description, .optional = identifier.optional}));
+    }
+
+    /* return a row-major matrix of double, by default copied from the vector of vectors */
+    virtual Matrix<double> Get(const ArgumentIdentifier<Matrix<double>>& identifier) const {
+        return Matrix<double>(Get(ArgumentIdentifier<std::vector<std::vector<double>>>{.inputName = identifier.inputName, .description = identifier.description, .optional = identifier.optional}));
+    }
+
+    /* return a row-major matrix of strings, by default copied from the vector of vectors */
+    virtual Matrix<std::string> Get(const ArgumentIdentifier<Matrix<std::string>>& identifier) const {
+        return Matrix<std::string>(
+            Get(ArgumentIdentifier<std::vector<std::vector<std::string>>>{.inputName = identifier.inputName, .description = identifier.description, .optional = identifier.optional}));
+    }
+
+    /* return a read only view of int values, by default copied from the vector */
+    virtual ArrayView<int> Get(const ArgumentIdentifier<ArrayView<int>>& identifier) const {
+        return ArrayView<int>(Get(ArgumentIdentifier<std::vector<int>>{.inputName = identifier.inputName, .description = identifier.description, .optional = identifier.optional}));
+    }
+
+    /* return a read only view of double values, by default copied from the vector */
+    virtual ArrayView<double> Get(const ArgumentIdentifier<ArrayView<double>>& identifier) const {
+        return ArrayView<double>(Get(ArgumentIdentifier<std::vector<double>>{.inputName = identifier.inputName, .description = identifier.description, .optional = identifier.optional}));
+    }
+
     /* check to see if the child is contained*/
     virtual bool Contains(const std::string& name) const = 0;
 
+    /**
+     * The TryGet family returns std::nullopt instead of throwing when the value is not in the factory.  An empty inputName refers to the value of this factory and is always
+     * present.  By default each is a Contains check followed by Get, factories that can find the value once override them.
+     */
+    virtual std::optional<std::string> TryGet(const ArgumentIdentifier<std::string>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<int> TryGet(const ArgumentIdentifier<int>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<bool> TryGet(const ArgumentIdentifier<bool>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<double> TryGet(const ArgumentIdentifier<double>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<std::vector<std::string>> TryGet(const ArgumentIdentifier<std::vector<std::string>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<std::vector<int>> TryGet(const ArgumentIdentifier<std::vector<int>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<std::vector<double>> TryGet(const ArgumentIdentifier<std::vector<double>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<std::vector<std::vector<int>>> TryGet(const ArgumentIdentifier<std::vector<std::vector<int>>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<std::vector<std::vector<double>>> TryGet(const ArgumentIdentifier<std::vector<std::vector<double>>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<std::vector<std::vector<std::string>>> TryGet(const ArgumentIdentifier<std::vector<std::vector<std::string>>>& identifier) const {
+        return TryGetIfContained(identifier);
+    }
+
+    virtual std::optional<std::map<std::string, std::string>> TryGet(const ArgumentIdentifier<std::map<std::string, std::string>>& identifier) const {
+        return TryGetIfContained(identifier);
+    }
+
+    virtual std::optional<Matrix<int>> TryGet(const ArgumentIdentifier<Matrix<int>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<Matrix<double>> TryGet(const ArgumentIdentifier<Matrix<double>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<Matrix<std::string>> TryGet(const ArgumentIdentifier<Matrix<std::string>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<ArrayView<int>> TryGet(const ArgumentIdentifier<ArrayView<int>>& identifier) const { return TryGetIfContained(identifier); }
+
+    virtual std::optional<ArrayView<double>> TryGet(const ArgumentIdentifier<ArrayView<double>>& identifier) const { return TryGetIfContained(identifier); }
+
+    /* return the factory for the child or nullptr when the child is not contained */
+    virtual std::shared_ptr<Factory> TryGetFactory(const std::string& name) const { return Contains(name) ? GetFactory(name) : nullptr; }
+
+    /* return the factories for the children of the sequence or std::nullopt when the sequence is not contained */
+    virtual std::optional<std::vector<std::shared_ptr<Factory>>> TryGetFactorySequence(const std::string& name) const {
+        if (!Contains(name)) {
+            return std::nullopt;
+        }
+        return GetFactorySequence(name);
+    }
+
     virtual std::unordered_set<std::string> GetKeys() const = 0;
 
+    /**
+     * Return the key and child factory of every entry in this factory.  The default looks up each of the GetKeys, implementations should visit the entries in a single pass and
+     * return them in document order.
+     */
+    virtual std::vector<std::pair<std::string, std::shared_ptr<Factory>>> GetFactoryEntries() const {
+        std::vector<std::pair<std::string, std::shared_ptr<Factory>>> entries;
+        for (const auto& key : GetKeys()) {
+            entries.emplace_back(key, GetFactory(key));
+        }
+        return entries;
+    }
+
     /* provide a virtual IsSameFactory function */
     virtual bool SameFactory(const Factory& otherFactory) const = 0;
 
+    /* return a structural hash of the factory, any two factories that are the SameFactory must have the same hash.  The default of zero puts every factory of a class type
+     * in the same bucket, so they are only told apart by SameFactory */
+    virtual std::size_t GetHash() const { return 0; }
+
     /* provide a virtual IsSameFactory function */
     inline bool operator==(const Factory& otherFactory) const { return SameFactory(otherFactory); }
 
@@ -81,6 +193,17 @@ class Factory {
     virtual std::vector<std::string> GetUnusedValues() const = 0;
 
    private:
+    /**
+     * The default TryGet, a Contains check followed by Get
+     */
+    template <typename T>
+    inline std::optional<T> TryGetIfContained(const ArgumentIdentifier<T>& identifier) const {
+        if (!identifier.inputName.empty() && !Contains(identifier.inputName)) {
+            return std::nullopt;
+        }
+        return Get(identifier);
+    }
+
     /**
      * Private function to create an instance from factory
      * @tparam Interface
@@ -89,42 +212,109 @@ class Factory {
      */
     template <typename Interface>
     std::shared_ptr<Interface> CreateInstanceFromFactory(const std::shared_ptr<Factory>& childFactory) const {
-        // check to see if the child factory has already been used to create an instance of the interface
+        auto createInstance = [&childFactory]() {
+            const auto& childType = childFactory->GetClassType();
+
+            // check the frozen registrations before resolving inherited classes
+            if (auto frozenCreateMethod = Creator<Interface>::GetFrozenCreateMethod(childType)) {
+                return (*frozenCreateMethod)(childFactory);
+            }
+
+            std::function<std::shared_ptr<Interface>(std::shared_ptr<Factory>)> createMethod = Creator<Interface>::GetCreateMethod(childType);
+            if (!createMethod) {
+                if (childType.empty()) {
+                    throw std::invalid_argument("no default creator specified for interface " + std::string(Demangler::Demangle<Interface>()));
+                } else {
+                    throw std::invalid_argument("unknown type " + childType);
+                }
+            }
+
+            return createMethod(childFactory);
+        };
+
+        // check to see if the child factory has already been used to create an instance of the interface, otherwise create and store it
         if (auto instanceTrackerPtr = instanceTracker.lock()) {
-            if (auto instance = instanceTrackerPtr->GetInstance<Interface>(childFactory)) {
+            auto [instance, created] = instanceTrackerPtr->template GetOrCreateInstance<Interface>(childFactory, createInstance);
+            if (!created) {
                 // Mark that child factory as using all children because this factory won't be used
                 childFactory->MarkAllUsed();
-
-                return instance;
             }
+            return instance;
         }
 
-        auto childType = childFactory->GetClassType();
-        std::function<std::shared_ptr<Interface>(std::shared_ptr<Factory>)> createMethod = Creator<Interface>::GetCreateMethod(childType);
-        if (!createMethod) {
-            if (childType.empty()) {
-                throw std::invalid_argument("no default creator specified for interface " + Demangler::Demangle<Interface>());
-            } else {
-                throw std::invalid_argument("unknown type " + childType);
+        return createInstance();
+    }
+
+    /**
+     * Create an instance from each of the child factories, in parallel when an executor is set and no ThreadScope is active on this thread.  The results are in the same
+     * order as the childFactories.
+     * @tparam Interface
+     * @param childFactories
+     * @return
+     */
+    template <typename Interface>
+    std::vector<std::shared_ptr<Interface>> CreateInstancesFromFactories(const std::vector<std::shared_ptr<Factory>>& childFactories) const {
+        std::vector<std::shared_ptr<Interface>> results(childFactories.size());
+        // the scoped instances belong to this thread, so they are never created on the executor threads
+        if (executor && childFactories.size() > 1 && !InstanceTracker::ThreadScope::IsActive()) {
+            std::vector<std::function<void()>> tasks;
+            tasks.reserve(childFactories.size());
+            for (std::size_t i = 0; i < childFactories.size(); i++) {
+                tasks.emplace_back([this, &results, &childFactories, i]() { results[i] = CreateInstanceFromFactory<Interface>(childFactories[i]); });
+            }
+            executor->Run(std::move(tasks));
+        } else {
+            for (std::size_t i = 0; i < childFactories.size(); i++) {
+                results[i] = CreateInstanceFromFactory<Interface>(childFactories[i]);
             }
         }
+        return results;
+    }
 
-        auto newInstance = createMethod(childFactory);
+    /**
+     * Create an instance from each entry of the factory, keyed by the child name and in the order of GetFactoryEntries
+     * @tparam Interface
+     * @param childFactory
+     * @return
+     */
+    template <typename Interface>
+    std::vector<std::pair<std::string, std::shared_ptr<Interface>>> CreateInstanceEntriesFromFactory(const std::shared_ptr<Factory>& childFactory) const {
+        auto entries = childFactory->GetFactoryEntries();
+
+        // Build the child factories before resolving them so they can be resolved in parallel
+        std::vector<std::shared_ptr<Factory>> subChildFactories;
+        subChildFactories.reserve(entries.size());
+        for (const auto& entry : entries) {
+            subChildFactories.push_back(entry.second);
+        }
+        auto instances = CreateInstancesFromFactories<Interface>(subChildFactories);
 
-        // store the instance if needed
-        if (auto instanceTrackerPtr = instanceTracker.lock()) {
-            instanceTrackerPtr->template SetInstance<Interface>(childFactory, newInstance);
+        std::vector<std::pair<std::string, std::shared_ptr<Interface>>> results;
+        results.reserve(entries.size());
+        for (std::size_t i = 0; i < entries.size(); i++) {
+            results.emplace_back(std::move(entries[i].first), std::move(instances[i]));
         }
+        return results;
+    }
 
-        return newInstance;
+    /**
+     * Create an instance from each child of the factory, keyed by the child name
+     * @tparam Interface
+     * @param childFactory
+     * @return
+     */
+    template <typename Interface>
+    std::map<std::string, std::shared_ptr<Interface>> CreateInstanceMapFromFactory(const std::shared_ptr<Factory>& childFactory) const {
+        auto entries = CreateInstanceEntriesFromFactory<Interface>(childFactory);
+        return std::map<std::string, std::shared_ptr<Interface>>(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
     }
 
    public:
     /* produce a shared pointer for the specified interface and type */
     template <typename Interface>
     std::shared_ptr<Interface> Get(const ArgumentIdentifier<Interface>& identifier) const {
-        if (identifier.optional && !Contains(identifier.inputName)) {
-            return {};
+        if (identifier.optional) {
+            return TryGet(identifier).value_or(nullptr);
         }
 
         // build the child factory
@@ -135,39 +325,66 @@ class Factory {
 
     template <typename Interface>
     std::vector<std::shared_ptr<Interface>> Get(const ArgumentIdentifier<std::vector<Interface>>& identifier) const {
-        if (identifier.optional && !Contains(identifier.inputName)) {
-            return {};
+        if (identifier.optional) {
+            return TryGet(identifier).value_or(std::vector<std::shared_ptr<Interface>>{});
         }
 
         auto childFactories = GetFactorySequence(identifier.inputName);
 
         // Build and resolve the list
-        std::vector<std::shared_ptr<Interface>> results;
-        for (auto childFactory : childFactories) {
-            results.push_back(CreateInstanceFromFactory<Interface>(childFactory));
+        return CreateInstancesFromFactories<Interface>(childFactories);
+    }
+
+    template <typename Interface>
+    std::map<std::string, std::shared_ptr<Interface>> Get(const ArgumentIdentifier<std::map<std::string, Interface>>& identifier) const {
+        if (identifier.optional) {
+            return TryGet(identifier).value_or(std::map<std::string, std::shared_ptr<Interface>>{});
         }
 
-        return results;
+        return CreateInstanceMapFromFactory<Interface>(GetFactory(identifier.inputName));
     }
 
+    /* produce the instances in the order of the input */
     template <typename Interface>
-    std::map<std::string, std::shared_ptr<Interface>> Get(const ArgumentIdentifier<std::map<std::string, Interface>>& identifier) const {
-        if (identifier.optional && !Contains(identifier.inputName)) {
-            return {};
+    OrderedMap<std::string, std::shared_ptr<Interface>> Get(const ArgumentIdentifier<OrderedMap<std::string, Interface>>& identifier) const {
+        if (identifier.optional) {
+            return TryGet(identifier).value_or(OrderedMap<std::string, std::shared_ptr<Interface>>{});
         }
 
-        auto childFactory = GetFactory(identifier.inputName);
-        auto childrenNames = childFactory->GetKeys();
+        return OrderedMap<std::string, std::shared_ptr<Interface>>(CreateInstanceEntriesFromFactory<Interface>(GetFactory(identifier.inputName)));
+    }
 
-        // Build and resolve the list
-        std::map<std::string, std::shared_ptr<Interface>> results;
-        for (auto childName : childrenNames) {
-            auto subChildFactory = childFactory->GetFactory(childName);
+    /* produce a shared pointer for the specified interface and type, std::nullopt when the child is not contained */
+    template <typename Interface>
+    std::optional<std::shared_ptr<Interface>> TryGet(const ArgumentIdentifier<Interface>& identifier) const {
+        if (auto childFactory = TryGetFactory(identifier.inputName)) {
+            return CreateInstanceFromFactory<Interface>(childFactory);
+        }
+        return std::nullopt;
+    }
 
-            results[childName] = (CreateInstanceFromFactory<Interface>(subChildFactory));
+    template <typename Interface>
+    std::optional<std::vector<std::shared_ptr<Interface>>> TryGet(const ArgumentIdentifier<std::vector<Interface>>& identifier) const {
+        if (auto childFactories = TryGetFactorySequence(identifier.inputName)) {
+            return CreateInstancesFromFactories<Interface>(*childFactories);
         }
+        return std::nullopt;
+    }
 
-        return results;
+    template <typename Interface>
+    std::optional<std::map<std::string, std::shared_ptr<Interface>>> TryGet(const ArgumentIdentifier<std::map<std::string, Interface>>& identifier) const {
+        if (auto childFactory = TryGetFactory(identifier.inputName)) {
+            return CreateInstanceMapFromFactory<Interface>(childFactory);
+        }
+        return std::nullopt;
+    }
+
+    template <typename Interface>
+    std::optional<OrderedMap<std::string, std::shared_ptr<Interface>>> TryGet(const ArgumentIdentifier<OrderedMap<std::string, Interface>>& identifier) const {
+        if (auto childFactory = TryGetFactory(identifier.inputName)) {
+            return OrderedMap<std::string, std::shared_ptr<Interface>>(CreateInstanceEntriesFromFactory<Interface>(childFactory));
+        }
+        return std::nullopt;
     }
 
     template <typename Interface>
@@ -177,8 +394,8 @@ class Factory {
 
     template <typename Interface, typename DefaultValueInterface>
     inline auto GetByName(const std::string& inputName, DefaultValueInterface defaultValue) const {
-        if (Contains(inputName)) {
-            return Get(ArgumentIdentifier<Interface>{.inputName = inputName, .description = "", .optional = false});
+        if (auto value = TryGet(ArgumentIdentifier<Interface>{.inputName = inputName, .description = "", .optional = false})) {
+            return std::move(*value);
         } else {
             return defaultValue;
         }
@@ -212,14 +429,35 @@ class Factory {
         return enumVector;
     }
 
+    template <typename ENUM>
+    std::optional<ENUM> TryGet(const ArgumentIdentifier<EnumWrapper<ENUM>>& identifier) const {
+        if (auto stringValue = TryGet(ArgumentIdentifier<std::string>{.inputName = identifier.inputName, .description = "", .optional = identifier.optional})) {
+            return EnumWrapper<ENUM>(*stringValue);
+        }
+        return std::nullopt;
+    }
+
+    template <typename ENUM>
+    std::optional<std::vector<ENUM>> TryGet(const ArgumentIdentifier<std::vector<EnumWrapper<ENUM>>>& identifier) const {
+        auto stringVector = TryGet(ArgumentIdentifier<std::vector<std::string>>{.inputName = identifier.inputName, .description = "", .optional = identifier.optional});
+        if (!stringVector) {
+            return std::nullopt;
+        }
+        std::vector<ENUM> enumVector;
+        for (const auto& enumString : *stringVector) {
+            enumVector.push_back(EnumWrapper<ENUM>(enumString));
+        }
+        return enumVector;
+    }
+
     /**
      * returns the path to a file as specified using a file locator instance
      * @param identifier
      * @return
      */
     virtual std::filesystem::path Get(const ArgumentIdentifier<std::filesystem::path>& identifier) const {
-        if (identifier.optional && !Contains(identifier.inputName)) {
-            return {};
+        if (identifier.optional) {
+            return TryGet(identifier).value_or(std::filesystem::path{});
         }
 
         // get the file locator instance
@@ -227,6 +465,13 @@ class Factory {
         return fileLocator->Locate();
     }
 
+    virtual std::optional<std::filesystem::path> TryGet(const ArgumentIdentifier<std::filesystem::path>& identifier) const {
+        if (auto fileLocator = TryGet(ArgumentIdentifier<cppParser::PathLocator>{.inputName = identifier.inputName})) {
+            return (*fileLocator)->Locate();
+        }
+        return std::nullopt;
+    }
+
    protected:
     /** Mark the values as used*/
     virtual void MarkAllUsed() const = 0;
@@ -0,0 +1,64 @@
+#include "flatDocument.hpp"
+#include <cstring>
+#include <utility>
+#include "mappedFile.hpp"
+
+cppParser::FlatDocument::FlatDocument(std::shared_ptr<const void> storage, const FlatNode* nodes, std::size_t nodeCount, const FlatEntry* entries, std::size_t entryCount,
+                                      std::string_view strings, std::uint32_t root, std::string_view arena)
+    : storage(std::move(storage)), nodes(nodes), nodeCount(nodeCount), entries(entries), entryCount(entryCount), strings(strings), arena(arena), root(root) {
+    // check every range so that later lookups do not need to
+    if (strings.size() > arenaOffsetFlag || arena.size() > arenaOffsetFlag) {
+        throw std::invalid_argument("the flat document strings are too large");
+    }
+    auto validString = [&strings, &arena](std::uint32_t offset, std::uint32_t length) {
+        return (offset & arenaOffsetFlag) ? (std::uint64_t)(offset & ~arenaOffsetFlag) + length <= arena.size() : (std::uint64_t)offset + length <= strings.size();
+    };
+    if (root >= nodeCount) {
+        throw std::invalid_argument("the flat document root is out of range");
+    }
+    for (std::size_t i = 0; i < nodeCount; i++) {
+        const auto& node = nodes[i];
+        if (node.type > FlatNodeType::Map || !validString(node.tagOffset, node.tagLength) || !validString(node.scalarOffset, node.scalarLength) ||
+            (std::uint64_t)node.firstEntry + node.entryCount > entryCount) {
+            throw std::invalid_argument("the flat document node " + std::to_string(i) + " is invalid");
+        }
+    }
+    for (std::size_t i = 0; i < entryCount; i++) {
+        if (!validString(entries[i].keyOffset, entries[i].keyLength) || entries[i].node >= nodeCount) {
+            throw std::invalid_argument("the flat document entry " + std::to_string(i) + " is invalid");
+        }
+    }
+}
+
+std::shared_ptr<const cppParser::FlatDocument> cppParser::FlatDocument::Map(const std::filesystem::path& path) {
+    auto bytes = std::make_shared<MappedFile>(path);
+
+    FlatHeader header{};
+    if (bytes->GetSize() < sizeof(FlatHeader)) {
+        throw std::invalid_argument(path.string() + " is not a binary config file");
+    }
+    std::memcpy(&header, bytes->GetData(), sizeof(FlatHeader));
+    if (std::memcmp(header.magic, FlatHeader::expectedMagic, sizeof(header.magic)) != 0) {
+        throw std::invalid_argument(path.string() + " is not a binary config file");
+    }
+    if (header.version != FlatHeader::expectedVersion || header.endianCheck != FlatHeader::expectedEndianCheck) {
+        throw std::invalid_argument(path.string() + " was written with an incompatible version or byte order");
+    }
+
+    // check that each section fits in the file
+    const std::uint64_t nodesOffset = sizeof(FlatHeader);
+    const std::uint64_t entriesOffset = nodesOffset + header.nodeCount * sizeof(FlatNode);
+    const std::uint64_t stringsOffset = entriesOffset + header.entryCount * sizeof(FlatEntry);
+    if (header.nodeCount > bytes->GetSize() || header.entryCount > bytes->GetSize() || stringsOffset + header.stringsSize != bytes->GetSize()) {
+        throw std::invalid_argument(path.string() + " is truncated or corrupt");
+    }
+
+    const auto data = bytes->GetData();
+    return std::make_shared<FlatDocument>(bytes,
+                                          reinterpret_cast<const FlatNode*>(data + nodesOffset),
+                                          header.nodeCount,
+                                          reinterpret_cast<const FlatEntry*>(data + entriesOffset),
+                                          header.entryCount,
+                                          std::string_view(data + stringsOffset, header.stringsSize),
+                                          header.root);
+}
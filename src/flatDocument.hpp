@@ -0,0 +1,116 @@
+#ifndef CPPPARSER_FLATDOCUMENT_HPP
+#define CPPPARSER_FLATDOCUMENT_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace cppParser {
+
+/**
+ * The type of each node in a flat document
+ */
+enum class FlatNodeType : std::uint32_t { Null = 0, Scalar = 1, Sequence = 2, Map = 3 };
+
+/**
+ * A node in a flat document.  Strings are referenced by offset/length into the document strings (or the arena when the offset has the arenaOffsetFlag) and the children are a
+ * range of entries.
+ */
+struct FlatNode {
+    FlatNodeType type;
+    std::uint32_t tagOffset;
+    std::uint32_t tagLength;
+    std::uint32_t scalarOffset;
+    std::uint32_t scalarLength;
+    std::uint32_t firstEntry;
+    std::uint32_t entryCount;
+    // the zero based position of the node in the source yaml, reported in conversion errors like the yaml-cpp marks
+    std::uint32_t line;
+    std::uint32_t column;
+};
+
+/**
+ * A child of a sequence or map node.  Sequence entries have an empty key.  Nodes shared by an anchor and its aliases are stored once and referenced by each entry.
+ */
+struct FlatEntry {
+    std::uint32_t keyOffset;
+    std::uint32_t keyLength;
+    std::uint32_t node;
+};
+
+/**
+ * The header at the start of a binary config file, followed by the nodes, entries, and strings
+ */
+struct FlatHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianCheck;
+    std::uint32_t root;
+    std::uint32_t reserved;
+    std::uint64_t nodeCount;
+    std::uint64_t entryCount;
+    std::uint64_t stringsSize;
+
+    inline static constexpr char expectedMagic[8] = {'C', 'P', 'P', 'P', 'B', 'I', 'N', '\0'};
+    inline static constexpr std::uint32_t expectedVersion = 2;
+    inline static constexpr std::uint32_t expectedEndianCheck = 0x01020304;
+};
+
+/**
+ * Marks a string offset into the arena of a flat document instead of the strings
+ */
+inline constexpr std::uint32_t arenaOffsetFlag = 0x80000000u;
+
+/**
+ * A read only document stored as flat arrays of nodes and entries.  The arrays and strings are views into the storage, which is kept alive by the document.  The arena holds
+ * strings that could not be referenced in place, i.e. quoted strings with escapes when the strings are the source text.
+ */
+class FlatDocument {
+   private:
+    const std::shared_ptr<const void> storage;
+    const FlatNode* const nodes;
+    const std::size_t nodeCount;
+    const FlatEntry* const entries;
+    const std::size_t entryCount;
+    const std::string_view strings;
+    const std::string_view arena;
+    const std::uint32_t root;
+
+   public:
+    /**
+     * Create the document from views into the storage.  The ranges in every node are validated.
+     */
+    FlatDocument(std::shared_ptr<const void> storage, const FlatNode* nodes, std::size_t nodeCount, const FlatEntry* entries, std::size_t entryCount, std::string_view strings,
+                 std::uint32_t root, std::string_view arena = {});
+
+    /**
+     * Memory map a binary config file written by the BinarySerializer
+     * @param path
+     * @return
+     */
+    static std::shared_ptr<const FlatDocument> Map(const std::filesystem::path& path);
+
+    [[nodiscard]] inline std::uint32_t GetRoot() const { return root; }
+
+    [[nodiscard]] inline const FlatNode& GetNode(std::uint32_t node) const { return nodes[node]; }
+
+    [[nodiscard]] inline const FlatEntry* BeginEntries(const FlatNode& node) const { return entries + node.firstEntry; }
+
+    [[nodiscard]] inline const FlatEntry* EndEntries(const FlatNode& node) const { return entries + node.firstEntry + node.entryCount; }
+
+    [[nodiscard]] inline std::string_view GetString(std::uint32_t offset, std::uint32_t length) const {
+        return (offset & arenaOffsetFlag) ? arena.substr(offset & ~arenaOffsetFlag, length) : strings.substr(offset, length);
+    }
+
+    [[nodiscard]] inline std::string_view GetTag(const FlatNode& node) const { return GetString(node.tagOffset, node.tagLength); }
+
+    [[nodiscard]] inline std::string_view GetScalar(const FlatNode& node) const { return GetString(node.scalarOffset, node.scalarLength); }
+
+    [[nodiscard]] inline std::string_view GetKey(const FlatEntry& entry) const { return GetString(entry.keyOffset, entry.keyLength); }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_FLATDOCUMENT_HPP
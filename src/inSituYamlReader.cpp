@@ -0,0 +1,1030 @@
+#include "inSituYamlReader.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "mappedFile.hpp"
+
+namespace {
+/**
+ * Everything referenced by an in situ document
+ */
+struct InSituStorage {
+    std::shared_ptr<const void> source;
+    std::vector<cppParser::FlatNode> nodes;
+    std::vector<cppParser::FlatEntry> entries;
+    std::string arena;
+};
+
+/**
+ * A string in the source text or the arena
+ */
+struct StringReference {
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
+};
+
+/**
+ * The optional tag and anchor before a node
+ */
+struct NodeProperties {
+    StringReference tag;
+    std::string_view anchor;
+
+    [[nodiscard]] bool Empty() const { return tag.length == 0 && anchor.empty(); }
+};
+
+/**
+ * A recursive descent parser over the source text.  Between block nodes the position is always at the start of a line.
+ */
+class InSituParser {
+   private:
+    const std::string_view text;
+    const std::string& sourceName;
+    InSituStorage& storage;
+    std::size_t pos = 0;
+    bool documentEnded = false;
+
+    // the node for each anchor, later anchors with the same name replace earlier ones
+    std::unordered_map<std::string_view, std::uint32_t> anchors;
+
+    // the start of the node being parsed, including its tag and anchor, used as the node position
+    std::size_t nodeStart = 0;
+
+    // the lines are counted up to countedPos, the nodes start in document order so the lines are only counted once
+    std::size_t countedPos = 0;
+    std::uint32_t countedLine = 0;
+    std::size_t countedLineStart = 0;
+
+    static inline bool IsBlank(char c) { return c == ' ' || c == '\t'; }
+    static inline bool IsBreak(char c) { return c == '\n' || c == '\r' || c == '\0'; }
+    static inline bool IsBlankOrBreak(char c) { return IsBlank(c) || IsBreak(c); }
+    static inline bool IsFlowIndicator(char c) { return c == ',' || c == '[' || c == ']' || c == '{' || c == '}'; }
+
+    [[nodiscard]] inline bool AtEnd() const { return pos >= text.size(); }
+    [[nodiscard]] inline char Peek(std::size_t offset = 0) const { return pos + offset < text.size() ? text[pos + offset] : '\0'; }
+
+    [[noreturn]] void Error(const std::string& message) const {
+        auto line = std::count(text.begin(), text.begin() + (std::ptrdiff_t)std::min(pos, text.size()), '\n') + 1;
+        throw std::invalid_argument("unable to parse " + sourceName + " at line " + std::to_string(line) + ": " + message);
+    }
+
+    [[nodiscard]] int Column() const {
+        auto lineStart = text.rfind('\n', pos == 0 ? 0 : pos - 1);
+        return (int)(lineStart == std::string_view::npos || pos == 0 ? pos : pos - lineStart - 1);
+    }
+
+    void SkipSpaces() {
+        while (IsBlank(Peek())) {
+            pos++;
+        }
+    }
+
+    void SkipToBreak() {
+        while (!IsBreak(Peek())) {
+            pos++;
+        }
+    }
+
+    void SkipComment() {
+        if (Peek() == '#') {
+            SkipToBreak();
+        }
+    }
+
+    void NextLine() {
+        if (Peek() == '\r') {
+            pos++;
+        }
+        if (Peek() == '\n') {
+            pos++;
+        }
+    }
+
+    /**
+     * Skip any spaces and comment, returning true if the rest of the line is empty
+     */
+    bool AtLineEnd() {
+        SkipSpaces();
+        SkipComment();
+        return IsBreak(Peek());
+    }
+
+    /**
+     * Expect the rest of the line to be empty and move to the next line
+     */
+    void FinishLine() {
+        if (!AtLineEnd()) {
+            Error("unexpected content after the value");
+        }
+        NextLine();
+    }
+
+    [[nodiscard]] bool IsDocumentMarker() const {
+        return Column() == 0 && (text.compare(pos, 3, "---") == 0 || text.compare(pos, 3, "...") == 0) && IsBlankOrBreak(Peek(3));
+    }
+
+    [[nodiscard]] bool IsSequenceIndicator() const { return Peek() == '-' && IsBlankOrBreak(Peek(1)); }
+
+    /**
+     * Skip blank and comment lines.  When content is found the position is left at the start of the line and the indent is returned.
+     */
+    bool SeekContent(int& indent) {
+        while (!documentEnded && !AtEnd()) {
+            auto lineStart = pos;
+            while (Peek() == ' ') {
+                pos++;
+            }
+            indent = (int)(pos - lineStart);
+            if (indent == 0 && IsDocumentMarker()) {
+                documentEnded = true;
+                break;
+            }
+            auto contentStart = pos;
+            if (AtLineEnd()) {
+                NextLine();
+                continue;
+            }
+            if (pos != contentStart) {
+                Error("tabs cannot be used for indentation");
+            }
+            pos = lineStart;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * The zero based line and column of the position
+     */
+    void Locate(std::size_t position, std::uint32_t& line, std::uint32_t& column) {
+        if (position < countedPos) {
+            countedPos = countedLineStart = 0;
+            countedLine = 0;
+        }
+        for (; countedPos < position; countedPos++) {
+            if (text[countedPos] == '\n') {
+                countedLine++;
+                countedLineStart = countedPos + 1;
+            }
+        }
+        line = countedLine;
+        column = (std::uint32_t)(position - countedLineStart);
+    }
+
+    StringReference InText(std::size_t start, std::size_t end) const { return StringReference{.offset = (std::uint32_t)start, .length = (std::uint32_t)(end - start)}; }
+
+    StringReference InArena(const std::string& value) {
+        if (storage.arena.size() + value.size() > cppParser::arenaOffsetFlag) {
+            Error("the decoded strings are too large");
+        }
+        StringReference reference{.offset = (std::uint32_t)storage.arena.size() | cppParser::arenaOffsetFlag, .length = (std::uint32_t)value.size()};
+        storage.arena.append(value);
+        return reference;
+    }
+
+    /**
+     * Reserve a node so that the anchor can be referenced by the children
+     */
+    std::uint32_t BeginNode(const NodeProperties& properties) {
+        auto index = (std::uint32_t)storage.nodes.size();
+        auto& node = storage.nodes.emplace_back();
+        Locate(std::min(nodeStart, text.size()), node.line, node.column);
+        if (!properties.anchor.empty()) {
+            anchors[properties.anchor] = index;
+        }
+        return index;
+    }
+
+    std::uint32_t EndNode(std::uint32_t index, cppParser::FlatNodeType type, const NodeProperties& properties, StringReference scalar = {},
+                          const std::vector<cppParser::FlatEntry>& nodeEntries = {}) {
+        // the children have already added their entries so these entries are contiguous
+        storage.nodes[index] = cppParser::FlatNode{.type = type,
+                                                   .tagOffset = properties.tag.offset,
+                                                   .tagLength = properties.tag.length,
+                                                   .scalarOffset = scalar.offset,
+                                                   .scalarLength = scalar.length,
+                                                   .firstEntry = (std::uint32_t)storage.entries.size(),
+                                                   .entryCount = (std::uint32_t)nodeEntries.size(),
+                                                   .line = storage.nodes[index].line,
+                                                   .column = storage.nodes[index].column};
+        storage.entries.insert(storage.entries.end(), nodeEntries.begin(), nodeEntries.end());
+        return index;
+    }
+
+    std::uint32_t AddScalar(const NodeProperties& properties, StringReference scalar) { return EndNode(BeginNode(properties), cppParser::FlatNodeType::Scalar, properties, scalar); }
+
+    std::uint32_t AddNull(const NodeProperties& properties) { return EndNode(BeginNode(properties), cppParser::FlatNodeType::Null, properties); }
+
+    /**
+     * Plain scalars that yaml treats as null
+     */
+    static bool IsNullScalar(std::string_view value) { return value.empty() || value == "~" || value == "null" || value == "Null" || value == "NULL"; }
+
+    /**
+     * The end of a tag, anchor, or alias name
+     */
+    [[nodiscard]] std::size_t NameEnd(bool flow) const {
+        auto end = pos;
+        while (end < text.size() && !IsBlankOrBreak(text[end]) && !(flow && IsFlowIndicator(text[end]))) {
+            end++;
+        }
+        return end;
+    }
+
+    void SkipFlowSpace() {
+        while (true) {
+            SkipSpaces();
+            SkipComment();
+            if (AtEnd()) {
+                Error("unterminated flow collection");
+            }
+            if (!IsBreak(Peek())) {
+                return;
+            }
+            NextLine();
+        }
+    }
+
+    void ParseProperties(NodeProperties& properties, bool flow) {
+        while (true) {
+            if (Peek() == '!') {
+                auto start = pos;
+                pos = NameEnd(flow);
+                auto tag = text.substr(start, pos - start);
+                if (tag.rfind("!!", 0) == 0) {
+                    // expand the secondary tag handle like yaml-cpp
+                    properties.tag = InArena("tag:yaml.org,2002:" + std::string(tag.substr(2)));
+                } else if (tag.rfind("!<", 0) == 0 && tag.back() == '>') {
+                    properties.tag = InArena(std::string(tag.substr(2, tag.size() - 3)));
+                } else {
+                    properties.tag = InText(start, pos);
+                }
+            } else if (Peek() == '&') {
+                auto start = ++pos;
+                pos = NameEnd(flow);
+                if (pos == start) {
+                    Error("an anchor must have a name");
+                }
+                properties.anchor = text.substr(start, pos - start);
+            } else {
+                return;
+            }
+            if (flow) {
+                SkipFlowSpace();
+            } else {
+                SkipSpaces();
+            }
+        }
+    }
+
+    std::uint32_t ParseAlias(bool flow) {
+        auto start = ++pos;
+        pos = NameEnd(flow);
+        auto anchor = anchors.find(text.substr(start, pos - start));
+        if (anchor == anchors.end()) {
+            Error("unknown anchor " + std::string(text.substr(start, pos - start)));
+        }
+        return anchor->second;
+    }
+
+    /**
+     * Decode the escapes and line folding in a quoted scalar
+     */
+    void DecodeQuoted(std::string_view raw, bool doubleQuoted, std::string& out) const {
+        std::size_t i = 0;
+        while (i < raw.size()) {
+            char c = raw[i];
+            if (c == '\r' || c == '\n') {
+                // trailing blanks are dropped, then a single break is a space and each following empty line is a break
+                while (!out.empty() && IsBlank(out.back())) {
+                    out.pop_back();
+                }
+                std::size_t breaks = 0;
+                while (i < raw.size() && (IsBlank(raw[i]) || raw[i] == '\r' || raw[i] == '\n')) {
+                    breaks += raw[i++] == '\n';
+                }
+                if (breaks <= 1) {
+                    out += ' ';
+                } else {
+                    out.append(breaks - 1, '\n');
+                }
+            } else if (!doubleQuoted) {
+                // the only single quoted escape is ''
+                out += c;
+                i += c == '\'' ? 2 : 1;
+            } else if (c == '\\') {
+                if (i + 1 >= raw.size()) {
+                    Error("incomplete escape sequence");
+                }
+                char escape = raw[i + 1];
+                i += 2;
+                std::size_t hexDigits = 0;
+                switch (escape) {
+                    case '0':
+                        out += '\0';
+                        break;
+                    case 'a':
+                        out += '\a';
+                        break;
+                    case 'b':
+                        out += '\b';
+                        break;
+                    case 't':
+                    case '\t':
+                        out += '\t';
+                        break;
+                    case 'n':
+                        out += '\n';
+                        break;
+                    case 'v':
+                        out += '\v';
+                        break;
+                    case 'f':
+                        out += '\f';
+                        break;
+                    case 'r':
+                        out += '\r';
+                        break;
+                    case 'e':
+                        out += '\x1b';
+                        break;
+                    case ' ':
+                    case '"':
+                    case '/':
+                    case '\\':
+                        out += escape;
+                        break;
+                    case 'N':
+                        AppendUtf8(out, 0x85);
+                        break;
+                    case '_':
+                        AppendUtf8(out, 0xA0);
+                        break;
+                    case 'L':
+                        AppendUtf8(out, 0x2028);
+                        break;
+                    case 'P':
+                        AppendUtf8(out, 0x2029);
+                        break;
+                    case 'x':
+                        hexDigits = 2;
+                        break;
+                    case 'u':
+                        hexDigits = 4;
+                        break;
+                    case 'U':
+                        hexDigits = 8;
+                        break;
+                    case '\r':
+                    case '\n':
+                        // an escaped line break joins the lines without a space
+                        while (i < raw.size() && (IsBlank(raw[i]) || raw[i] == '\n')) {
+                            i++;
+                        }
+                        break;
+                    default:
+                        Error(std::string("unknown escape sequence \\") + escape);
+                }
+                if (hexDigits) {
+                    if (i + hexDigits > raw.size()) {
+                        Error("incomplete escape sequence");
+                    }
+                    std::uint32_t codePoint = 0;
+                    for (std::size_t d = 0; d < hexDigits; d++) {
+                        char h = raw[i++];
+                        codePoint <<= 4;
+                        if (h >= '0' && h <= '9') {
+                            codePoint |= (std::uint32_t)(h - '0');
+                        } else if (h >= 'a' && h <= 'f') {
+                            codePoint |= (std::uint32_t)(h - 'a' + 10);
+                        } else if (h >= 'A' && h <= 'F') {
+                            codePoint |= (std::uint32_t)(h - 'A' + 10);
+                        } else {
+                            Error("invalid hex escape sequence");
+                        }
+                    }
+                    AppendUtf8(out, codePoint);
+                }
+            } else {
+                out += c;
+                i++;
+            }
+        }
+    }
+
+    static void AppendUtf8(std::string& out, std::uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out += (char)codePoint;
+        } else if (codePoint < 0x800) {
+            out += (char)(0xC0 | (codePoint >> 6));
+            out += (char)(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += (char)(0xE0 | (codePoint >> 12));
+            out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codePoint & 0x3F));
+        } else {
+            out += (char)(0xF0 | (codePoint >> 18));
+            out += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+            out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+            out += (char)(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    /**
+     * Parse a single or double quoted scalar.  Scalars without escapes or line breaks reference the source text.
+     */
+    StringReference ParseQuoted() {
+        const char quote = Peek();
+        const bool doubleQuoted = quote == '"';
+        auto start = ++pos;
+        bool inPlace = true;
+        while (true) {
+            if (AtEnd()) {
+                Error("unterminated quoted scalar");
+            }
+            char c = Peek();
+            if (c == quote) {
+                if (!doubleQuoted && Peek(1) == '\'') {
+                    inPlace = false;
+                    pos += 2;
+                    continue;
+                }
+                break;
+            }
+            if (doubleQuoted && c == '\\') {
+                inPlace = false;
+                pos += 2;
+                continue;
+            }
+            if (c == '\n' || c == '\r') {
+                inPlace = false;
+            }
+            pos++;
+        }
+        auto end = pos++;
+        if (inPlace) {
+            return InText(start, end);
+        }
+        std::string decoded;
+        DecodeQuoted(text.substr(start, end - start), doubleQuoted, decoded);
+        return InArena(decoded);
+    }
+
+    /**
+     * Check if the rest of the line is an implicit mapping key, i.e. "key: value"
+     */
+    [[nodiscard]] bool IsMappingLine() const {
+        auto i = pos;
+        if (i < text.size() && (text[i] == '"' || text[i] == '\'')) {
+            const char quote = text[i++];
+            while (i < text.size() && !IsBreak(text[i])) {
+                if (text[i] == quote) {
+                    if (quote == '\'' && i + 1 < text.size() && text[i + 1] == '\'') {
+                        i += 2;
+                        continue;
+                    }
+                    break;
+                }
+                i += (quote == '"' && text[i] == '\\') ? 2 : 1;
+            }
+            if (i >= text.size() || text[i] != quote) {
+                return false;
+            }
+            i++;
+            while (i < text.size() && IsBlank(text[i])) {
+                i++;
+            }
+            return i < text.size() && text[i] == ':' && (i + 1 >= text.size() || IsBlankOrBreak(text[i + 1]));
+        }
+        for (; i < text.size() && !IsBreak(text[i]); i++) {
+            if (text[i] == '#' && i > pos && IsBlank(text[i - 1])) {
+                return false;
+            }
+            if (text[i] == ':' && (i + 1 >= text.size() || IsBlankOrBreak(text[i + 1]))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Parse an implicit block mapping key up to and including the ':'
+     */
+    StringReference ParseBlockKey() {
+        StringReference key;
+        if (Peek() == '"' || Peek() == '\'') {
+            key = ParseQuoted();
+            SkipSpaces();
+        } else {
+            auto start = pos;
+            while (!IsBreak(Peek()) && !(Peek() == ':' && IsBlankOrBreak(Peek(1)))) {
+                pos++;
+            }
+            auto end = pos;
+            while (end > start && IsBlank(text[end - 1])) {
+                end--;
+            }
+            if (end == start) {
+                Error("a mapping key cannot be empty");
+            }
+            key = InText(start, end);
+        }
+        if (Peek() != ':') {
+            Error("expected ':' after the mapping key");
+        }
+        pos++;
+        return key;
+    }
+
+    /**
+     * Parse the node after a "- " or "key:" indicator (or the document start)
+     * @param parentIndent the indent of the collection holding the node
+     * @param mapValue true when the node is a mapping value, which allows a sequence at the same indent
+     */
+    std::uint32_t ParseBlockNode(int parentIndent, bool mapValue) {
+        SkipSpaces();
+        nodeStart = pos;
+        NodeProperties properties;
+        ParseProperties(properties, false);
+        if (Peek() == '*') {
+            if (!properties.Empty()) {
+                Error("an alias cannot have a tag or anchor");
+            }
+            auto node = ParseAlias(false);
+            FinishLine();
+            return node;
+        }
+
+        if (!AtLineEnd()) {
+            return ParseBlockContent(Column(), parentIndent, mapValue, properties, true);
+        }
+
+        // the node starts on a following line or is null
+        NextLine();
+        int indent;
+        if (SeekContent(indent)) {
+            pos += indent;
+            if (indent > parentIndent || (mapValue && indent == parentIndent && IsSequenceIndicator())) {
+                if (properties.Empty()) {
+                    nodeStart = pos;
+                }
+                return ParseBlockContent(indent, parentIndent, false, properties, false);
+            }
+            pos -= indent;
+        }
+        return AddNull(properties);
+    }
+
+    std::uint32_t ParseBlockContent(int column, int parentIndent, bool mapValue, const NodeProperties& properties, bool sameLine) {
+        const char c = Peek();
+        if (c == '[' || c == '{') {
+            auto node = ParseFlowContent(properties);
+            FinishLine();
+            return node;
+        }
+        if (c == '|' || c == '>') {
+            return ParseBlockScalar(parentIndent, properties);
+        }
+        if (IsSequenceIndicator()) {
+            if (mapValue && sameLine) {
+                Error("a block sequence cannot start on the same line as its key");
+            }
+            return ParseBlockSequence(column, properties);
+        }
+        if (c == '?' && IsBlankOrBreak(Peek(1))) {
+            Error("complex mapping keys are not supported");
+        }
+        if (IsMappingLine()) {
+            if (mapValue && sameLine) {
+                Error("a block mapping cannot start on the same line as its key");
+            }
+            if (sameLine && !properties.Empty()) {
+                Error("tags and anchors on mapping keys are not supported");
+            }
+            return ParseBlockMapping(column, properties);
+        }
+        return ParseBlockScalarLine(parentIndent, properties);
+    }
+
+    std::uint32_t ParseBlockSequence(int column, const NodeProperties& properties) {
+        auto index = BeginNode(properties);
+        std::vector<cppParser::FlatEntry> items;
+        while (true) {
+            // skip the '-'
+            pos++;
+            items.push_back(cppParser::FlatEntry{.keyOffset = 0, .keyLength = 0, .node = ParseBlockNode(column, false)});
+
+            int indent;
+            if (!SeekContent(indent) || indent < column) {
+                break;
+            }
+            pos += indent;
+            if (indent > column) {
+                Error("unexpected indentation");
+            }
+            if (!IsSequenceIndicator()) {
+                pos -= indent;
+                break;
+            }
+        }
+        return EndNode(index, cppParser::FlatNodeType::Sequence, properties, {}, items);
+    }
+
+    std::uint32_t ParseBlockMapping(int column, const NodeProperties& properties) {
+        auto index = BeginNode(properties);
+        std::vector<cppParser::FlatEntry> items;
+        while (true) {
+            const char c = Peek();
+            if (c == '?' && IsBlankOrBreak(Peek(1))) {
+                Error("complex mapping keys are not supported");
+            }
+            if (c == '!' || c == '&' || c == '*') {
+                Error("tags, anchors, and aliases on mapping keys are not supported");
+            }
+            if (IsSequenceIndicator()) {
+                Error("expected a mapping key");
+            }
+            auto key = ParseBlockKey();
+            items.push_back(cppParser::FlatEntry{.keyOffset = key.offset, .keyLength = key.length, .node = ParseBlockNode(column, true)});
+
+            int indent;
+            if (!SeekContent(indent) || indent < column) {
+                break;
+            }
+            pos += indent;
+            if (indent > column) {
+                Error("unexpected indentation");
+            }
+        }
+        return EndNode(index, cppParser::FlatNodeType::Map, properties, {}, items);
+    }
+
+    /**
+     * Parse a quoted or plain scalar in block context.  Plain scalars continue on following lines that are indented more than the parent.
+     */
+    std::uint32_t ParseBlockScalarLine(int parentIndent, const NodeProperties& properties) {
+        if (Peek() == '"' || Peek() == '\'') {
+            auto scalar = ParseQuoted();
+            FinishLine();
+            return AddScalar(properties, scalar);
+        }
+
+        auto start = pos;
+        auto end = PlainLineEnd();
+        NextLine();
+
+        std::string folded;
+        bool isFolded = false;
+        while (!documentEnded && !AtEnd()) {
+            auto continuationStart = pos;
+            std::size_t emptyLines = 0;
+            int indent = 0;
+            while (!AtEnd()) {
+                auto lineStart = pos;
+                while (Peek() == ' ') {
+                    pos++;
+                }
+                indent = (int)(pos - lineStart);
+                SkipSpaces();
+                if (!IsBreak(Peek()) || AtEnd()) {
+                    break;
+                }
+                emptyLines++;
+                NextLine();
+            }
+            if (AtEnd() || indent <= parentIndent || Peek() == '#' || (indent == 0 && IsDocumentMarker())) {
+                pos = continuationStart;
+                break;
+            }
+            if (IsMappingLine()) {
+                Error("unexpected indentation");
+            }
+
+            if (!isFolded) {
+                folded.assign(text.substr(start, end - start));
+                isFolded = true;
+            }
+            if (emptyLines) {
+                folded.append(emptyLines, '\n');
+            } else {
+                folded += ' ';
+            }
+            auto lineStart = pos;
+            auto lineEnd = PlainLineEnd();
+            folded.append(text.substr(lineStart, lineEnd - lineStart));
+            NextLine();
+        }
+
+        if (isFolded) {
+            return AddScalar(properties, InArena(folded));
+        }
+        if (IsNullScalar(text.substr(start, end - start))) {
+            return AddNull(properties);
+        }
+        return AddScalar(properties, InText(start, end));
+    }
+
+    /**
+     * Move to the end of the line and return the end of the plain scalar on it, without any comment or trailing blanks
+     */
+    std::size_t PlainLineEnd() {
+        auto start = pos;
+        auto end = pos;
+        while (!IsBreak(Peek())) {
+            if (Peek() == '#' && pos > start && IsBlank(text[pos - 1])) {
+                SkipToBreak();
+                break;
+            }
+            pos++;
+            if (!IsBlank(text[pos - 1])) {
+                end = pos;
+            }
+        }
+        return end;
+    }
+
+    /**
+     * Parse a literal (|) or folded (>) block scalar
+     */
+    std::uint32_t ParseBlockScalar(int parentIndent, const NodeProperties& properties) {
+        const bool literal = Peek() == '|';
+        pos++;
+        char chomping = 'c';
+        int contentIndent = -1;
+        for (int i = 0; i < 2; i++) {
+            if (Peek() == '-' || Peek() == '+') {
+                chomping = Peek();
+                pos++;
+            } else if (Peek() >= '1' && Peek() <= '9') {
+                contentIndent = std::max(parentIndent, 0) + (Peek() - '0');
+                pos++;
+            }
+        }
+        FinishLine();
+
+        // collect the lines, an empty line holds only spaces
+        std::vector<std::string_view> lines;
+        while (!AtEnd()) {
+            auto lineStart = pos;
+            while (Peek() == ' ') {
+                pos++;
+            }
+            auto indent = (int)(pos - lineStart);
+            if (IsBreak(Peek()) && !AtEnd()) {
+                lines.emplace_back();
+                NextLine();
+                continue;
+            }
+            if (AtEnd()) {
+                break;
+            }
+            if (contentIndent < 0) {
+                contentIndent = indent;
+            }
+            if (indent < contentIndent || indent <= parentIndent || (indent == 0 && IsDocumentMarker())) {
+                pos = lineStart;
+                break;
+            }
+            pos = lineStart + contentIndent;
+            auto contentStart = pos;
+            SkipToBreak();
+            lines.push_back(text.substr(contentStart, pos - contentStart));
+            NextLine();
+        }
+
+        // trailing empty lines only count for keep chomping
+        std::size_t trailingEmpty = 0;
+        while (!lines.empty() && lines.back().empty()) {
+            lines.pop_back();
+            trailingEmpty++;
+        }
+
+        std::string value;
+        std::size_t emptyLines = 0;
+        bool first = true;
+        bool previousMoreIndented = false;
+        for (const auto& line : lines) {
+            if (line.empty()) {
+                emptyLines++;
+                continue;
+            }
+            bool moreIndented = IsBlank(line[0]);
+            if (first) {
+                value.append(emptyLines, '\n');
+            } else if (!literal && !moreIndented && !previousMoreIndented) {
+                // folded lines are joined with a space unless separated by empty lines
+                if (emptyLines) {
+                    value.append(emptyLines, '\n');
+                } else {
+                    value += ' ';
+                }
+            } else {
+                value.append(emptyLines + 1, '\n');
+            }
+            value.append(line);
+            first = false;
+            emptyLines = 0;
+            previousMoreIndented = moreIndented;
+        }
+        if (chomping == '+') {
+            value.append((lines.empty() ? 0 : 1) + trailingEmpty, '\n');
+        } else if (chomping == 'c' && !lines.empty()) {
+            value += '\n';
+        }
+
+        return AddScalar(properties, InArena(value));
+    }
+
+    std::uint32_t ParseFlowNode() {
+        nodeStart = pos;
+        NodeProperties properties;
+        ParseProperties(properties, true);
+        if (Peek() == '*') {
+            if (!properties.Empty()) {
+                Error("an alias cannot have a tag or anchor");
+            }
+            return ParseAlias(true);
+        }
+        return ParseFlowContent(properties);
+    }
+
+    std::uint32_t ParseFlowContent(const NodeProperties& properties) {
+        const char c = Peek();
+        if (c == '[') {
+            return ParseFlowSequence(properties);
+        }
+        if (c == '{') {
+            return ParseFlowMapping(properties);
+        }
+        if (c == '"' || c == '\'') {
+            return AddScalar(properties, ParseQuoted());
+        }
+
+        auto start = pos;
+        auto end = PlainFlowEnd();
+        if (IsNullScalar(text.substr(start, end - start))) {
+            return AddNull(properties);
+        }
+        return AddScalar(properties, InText(start, end));
+    }
+
+    /**
+     * Move past a plain scalar in a flow collection and return its end without trailing blanks
+     */
+    std::size_t PlainFlowEnd() {
+        auto start = pos;
+        auto end = pos;
+        while (!IsBreak(Peek()) && !IsFlowIndicator(Peek()) && !(Peek() == ':' && (IsBlankOrBreak(Peek(1)) || IsFlowIndicator(Peek(1)))) &&
+               !(Peek() == '#' && pos > start && IsBlank(text[pos - 1]))) {
+            pos++;
+            if (!IsBlank(text[pos - 1])) {
+                end = pos;
+            }
+        }
+        return end;
+    }
+
+    std::uint32_t ParseFlowSequence(const NodeProperties& properties) {
+        auto index = BeginNode(properties);
+        std::vector<cppParser::FlatEntry> items;
+        pos++;
+        while (true) {
+            SkipFlowSpace();
+            if (Peek() == ']') {
+                pos++;
+                break;
+            }
+            items.push_back(cppParser::FlatEntry{.keyOffset = 0, .keyLength = 0, .node = ParseFlowNode()});
+            SkipFlowSpace();
+            if (Peek() == ':') {
+                Error("single pair mappings in flow sequences are not supported");
+            }
+            if (Peek() == ',') {
+                pos++;
+            } else if (Peek() != ']') {
+                Error("expected ',' or ']' in the flow sequence");
+            }
+        }
+        return EndNode(index, cppParser::FlatNodeType::Sequence, properties, {}, items);
+    }
+
+    std::uint32_t ParseFlowMapping(const NodeProperties& properties) {
+        auto index = BeginNode(properties);
+        std::vector<cppParser::FlatEntry> items;
+        pos++;
+        while (true) {
+            SkipFlowSpace();
+            if (Peek() == '}') {
+                pos++;
+                break;
+            }
+            if (Peek() == '?' || Peek() == '!' || Peek() == '&' || Peek() == '*' || Peek() == '[' || Peek() == '{') {
+                Error("only plain or quoted mapping keys are supported");
+            }
+            StringReference key;
+            if (Peek() == '"' || Peek() == '\'') {
+                key = ParseQuoted();
+            } else {
+                auto start = pos;
+                key = InText(start, PlainFlowEnd());
+            }
+            SkipFlowSpace();
+
+            std::uint32_t value;
+            nodeStart = pos;
+            if (Peek() == ':') {
+                pos++;
+                SkipFlowSpace();
+                nodeStart = pos;
+                value = (Peek() == ',' || Peek() == '}') ? AddNull({}) : ParseFlowNode();
+                SkipFlowSpace();
+            } else {
+                value = AddNull({});
+            }
+            items.push_back(cppParser::FlatEntry{.keyOffset = key.offset, .keyLength = key.length, .node = value});
+
+            if (Peek() == ',') {
+                pos++;
+            } else if (Peek() != '}') {
+                Error("expected ',' or '}' in the flow mapping");
+            }
+        }
+        return EndNode(index, cppParser::FlatNodeType::Map, properties, {}, items);
+    }
+
+   public:
+    InSituParser(std::string_view text, const std::string& sourceName, InSituStorage& storage) : text(text), sourceName(sourceName), storage(storage) {
+        if (text.size() >= cppParser::arenaOffsetFlag) {
+            throw std::invalid_argument(sourceName + " is too large to read in place");
+        }
+    }
+
+    std::uint32_t ParseDocument() {
+        // skip the directives, comments, and empty lines before the document
+        while (!AtEnd()) {
+            auto lineStart = pos;
+            if (Column() == 0 && Peek() == '%') {
+                SkipToBreak();
+                NextLine();
+                continue;
+            }
+            if (Column() == 0 && text.compare(pos, 3, "---") == 0 && IsBlankOrBreak(Peek(3))) {
+                pos += 3;
+                return FinishDocument(ParseBlockNode(-1, false));
+            }
+            if (AtLineEnd() && !AtEnd()) {
+                NextLine();
+                continue;
+            }
+            pos = lineStart;
+            break;
+        }
+
+        int indent;
+        if (!SeekContent(indent)) {
+            return AddNull({});
+        }
+        pos += indent;
+        return FinishDocument(ParseBlockNode(-1, false));
+    }
+
+    std::uint32_t FinishDocument(std::uint32_t root) {
+        int indent;
+        if (SeekContent(indent)) {
+            pos += indent;
+            Error("unexpected content after the document");
+        }
+        return root;
+    }
+};
+
+std::shared_ptr<const cppParser::FlatDocument> CreateDocument(std::shared_ptr<InSituStorage> storage, std::string_view text, const std::string& sourceName) {
+    // the byte order mark is not part of the first line
+    if (text.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        text.remove_prefix(3);
+    }
+
+    InSituParser parser(text, sourceName, *storage);
+    auto root = parser.ParseDocument();
+
+    const auto& nodes = storage->nodes;
+    const auto& entries = storage->entries;
+    std::string_view arena = storage->arena;
+    return std::make_shared<cppParser::FlatDocument>(storage, nodes.data(), nodes.size(), entries.data(), entries.size(), text, root, arena);
+}
+}  // namespace
+
+std::shared_ptr<const cppParser::FlatDocument> cppParser::InSituYamlReader::Read(const std::filesystem::path& path) {
+    auto file = std::make_shared<MappedFile>(path);
+    auto storage = std::make_shared<InSituStorage>();
+    storage->source = file;
+    return CreateDocument(storage, file->GetView(), path.string());
+}
+
+std::shared_ptr<const cppParser::FlatDocument> cppParser::InSituYamlReader::ReadString(std::string yaml) {
+    auto source = std::make_shared<std::string>(std::move(yaml));
+    auto storage = std::make_shared<InSituStorage>();
+    storage->source = source;
+    return CreateDocument(storage, *source, "yaml string");
+}
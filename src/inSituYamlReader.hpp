@@ -0,0 +1,38 @@
+#ifndef CPPPARSER_INSITUYAMLREADER_HPP
+#define CPPPARSER_INSITUYAMLREADER_HPP
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include "flatDocument.hpp"
+
+namespace cppParser {
+
+/**
+ * Reads a yaml document in place into a flat document.  The nodes and entries are stored in flat arrays and every tag, key, and scalar that does not need decoding is a view into
+ * the (memory mapped) source text.  Escaped/folded strings are decoded once into the document arena.
+ *
+ * The block and flow styles, quoted and block scalars, tags, anchors, and aliases are supported.  Complex keys, tags or anchors on mapping keys, and single pair mappings in flow
+ * sequences are reported as errors.  Only the first document in the source is read, matching YAML::Load.
+ */
+class InSituYamlReader {
+   public:
+    InSituYamlReader() = delete;
+
+    /**
+     * Memory map and read the yaml file
+     * @param path
+     * @return
+     */
+    static std::shared_ptr<const FlatDocument> Read(const std::filesystem::path& path);
+
+    /**
+     * Read the yaml string.  The string is moved into the document storage.
+     * @param yaml
+     * @return
+     */
+    static std::shared_ptr<const FlatDocument> ReadString(std::string yaml);
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_INSITUYAMLREADER_HPP
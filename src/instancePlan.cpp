@@ -0,0 +1,31 @@
+#include "instancePlan.hpp"
+#include <algorithm>
+
+std::size_t cppParser::InstancePlan::ComputeLevel(std::size_t node, std::vector<std::optional<std::size_t>>& levels) const {
+    if (!levels[node]) {
+        std::size_t level = 0;
+        for (auto dependency : nodes[node].dependencies) {
+            level = std::max(level, ComputeLevel(dependency, levels) + 1);
+        }
+        levels[node] = level;
+    }
+    return *levels[node];
+}
+
+void cppParser::InstancePlan::Execute(Executor& executor) {
+    // group the nodes by level
+    std::vector<std::optional<std::size_t>> levels(nodes.size());
+    std::vector<std::vector<std::function<void()>>> levelTasks;
+    for (std::size_t node = 0; node < nodes.size(); node++) {
+        auto level = ComputeLevel(node, levels);
+        if (levelTasks.size() <= level) {
+            levelTasks.resize(level + 1);
+        }
+        levelTasks[level].push_back(nodes[node].createInstance);
+    }
+
+    // every dependency is in a lower level, so each level can be created in parallel
+    for (auto& tasks : levelTasks) {
+        executor.Run(std::move(tasks));
+    }
+}
@@ -0,0 +1,176 @@
+#ifndef CPPPARSER_INSTANCEPLAN_HPP
+#define CPPPARSER_INSTANCEPLAN_HPP
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "factory.hpp"
+
+namespace cppParser {
+
+/**
+ * The instance plan walks a factory tree against the registered arguments of each class to build the dependency graph of the instances that will be created.  Each instance
+ * depends on the instances created from its interface arguments.  Executing the plan creates the instances level by level (leaves first) in parallel and stores them in the
+ * InstanceTracker, so the final create only has to assemble the already built instances.
+ */
+class InstancePlan {
+   private:
+    /**
+     * A single instance to be created from a factory
+     */
+    struct Node {
+        std::shared_ptr<Factory> factory;
+        std::function<void()> createInstance;
+        std::vector<std::size_t> dependencies;
+        bool planned = false;
+    };
+
+    std::vector<Node> nodes;
+
+    // nodes are indexed by the factory hash so that shared factories (i.e. anchors) are only created once
+    std::unordered_multimap<std::size_t, std::size_t> nodeIndex;
+
+    /**
+     * Checks if the argument of type T is created from a factory as a single interface, a sequence of interfaces, or a map of interfaces
+     */
+    template <typename T>
+    using GetResult = decltype(std::declval<const Factory&>().Get(std::declval<const ArgumentIdentifier<T>&>()));
+
+    template <typename T>
+    struct InterfaceArgument {
+        static constexpr bool value = std::is_same_v<GetResult<T>, std::shared_ptr<T>>;
+    };
+
+    template <typename T>
+    struct SequenceArgument : std::false_type {};
+    template <typename T>
+    struct SequenceArgument<std::vector<T>> {
+        static constexpr bool value = std::is_same_v<GetResult<std::vector<T>>, std::vector<std::shared_ptr<T>>>;
+    };
+
+    template <typename T>
+    struct MapArgument : std::false_type {};
+    template <typename T>
+    struct MapArgument<std::map<std::string, T>> {
+        static constexpr bool value = std::is_same_v<GetResult<std::map<std::string, T>>, std::map<std::string, std::shared_ptr<T>>>;
+    };
+    template <typename T>
+    struct MapArgument<OrderedMap<std::string, T>> {
+        static constexpr bool value = std::is_same_v<GetResult<OrderedMap<std::string, T>>, OrderedMap<std::string, std::shared_ptr<T>>>;
+    };
+
+    /**
+     * Add a dependency from the parent node, the parent is empty for the root of the plan
+     */
+    void AddDependency(std::optional<std::size_t> parent, std::size_t dependency) {
+        // a dependency that is still being planned is an ancestor of the parent, so the cycle is left to the normal create
+        if (parent && nodes[dependency].planned) {
+            nodes[*parent].dependencies.push_back(dependency);
+        }
+    }
+
+    /**
+     * Compute the level of each node, where a node is one level above its deepest dependency
+     */
+    std::size_t ComputeLevel(std::size_t node, std::vector<std::optional<std::size_t>>& levels) const;
+
+   public:
+    /**
+     * Add the instance of Interface created from the factory (and all of its dependencies) to the plan
+     * @tparam Interface
+     * @param factory
+     * @return the index of the node in the plan
+     */
+    template <typename Interface>
+    std::size_t Add(const std::shared_ptr<Factory>& factory) {
+        // check to see if this factory has already been planned
+        auto hash = factory->GetHash();
+        auto range = nodeIndex.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const auto& node = nodes[it->second];
+            if (node.factory->GetClassType() == factory->GetClassType() && *node.factory == *factory) {
+                return it->second;
+            }
+        }
+
+        auto index = nodes.size();
+        nodes.push_back(Node{.factory = factory, .createInstance = [factory]() { factory->template CreateInstanceFromFactory<Interface>(factory); }, .dependencies = {}});
+        nodeIndex.emplace(hash, index);
+
+        // plan the arguments of the class that will be created
+        if (auto planMethod = Creator<Interface>::GetPlanMethod(factory->GetClassType())) {
+            planMethod(factory, *this, index);
+        }
+        nodes[index].planned = true;
+        return index;
+    }
+
+    /**
+     * Add the instances created for the argument to the plan.  Arguments that are not created from a factory are ignored.
+     * @tparam T
+     * @param factory the factory that the argument is read from
+     * @param parent the node that depends on the argument
+     * @param identifier
+     */
+    template <typename T>
+    void AddArgument(const std::shared_ptr<Factory>& factory, std::optional<std::size_t> parent, const ArgumentIdentifier<T>& identifier) {
+        if constexpr (InterfaceArgument<T>::value || SequenceArgument<T>::value || MapArgument<T>::value) {
+            if (identifier.optional && !factory->Contains(identifier.inputName)) {
+                return;
+            }
+            try {
+                if constexpr (InterfaceArgument<T>::value) {
+                    AddDependency(parent, Add<T>(factory->GetFactory(identifier.inputName)));
+                } else if constexpr (SequenceArgument<T>::value) {
+                    for (const auto& childFactory : factory->GetFactorySequence(identifier.inputName)) {
+                        AddDependency(parent, Add<typename T::value_type>(childFactory));
+                    }
+                } else {
+                    for (const auto& entry : factory->GetFactory(identifier.inputName)->GetFactoryEntries()) {
+                        AddDependency(parent, Add<typename T::mapped_type>(entry.second));
+                    }
+                }
+            } catch (const std::invalid_argument&) {
+                // invalid input is left out of the plan and reported when the instance is created
+            }
+        }
+    }
+
+    /**
+     * Create every planned instance.  Each level of the plan is run in parallel with the executor.
+     * @param executor
+     */
+    void Execute(Executor& executor);
+
+    /**
+     * The number of instances in the plan
+     */
+    [[nodiscard]] std::size_t Size() const { return nodes.size(); }
+
+    /**
+     * Plan and create every instance needed for the argument in parallel before returning the result from the factory.  The plan is only executed when the factory has both an
+     * instance tracker to store the instances and an executor and no ThreadScope is active on this thread, otherwise this is the same as factory->Get(identifier).
+     * @tparam T
+     * @param factory
+     * @param identifier
+     * @return
+     */
+    template <typename T>
+    static auto Get(const std::shared_ptr<Factory>& factory, const ArgumentIdentifier<T>& identifier) {
+        if (factory->executor && !factory->instanceTracker.expired() && !InstanceTracker::ThreadScope::IsActive()) {
+            InstancePlan plan;
+            plan.AddArgument(factory, std::nullopt, identifier);
+            plan.Execute(*factory->executor);
+        }
+        return factory->Get(identifier);
+    }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_INSTANCEPLAN_HPP
@@ -1,18 +1,281 @@
 #include "instanceTracker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
 #include "factory.hpp"
 
+/**
+ * The same factory object (i.e. a resolved !ref) is found without comparing the factories
+ */
+static inline bool IsSameFactory(const std::shared_ptr<cppParser::Factory>& stored, const std::shared_ptr<cppParser::Factory>& factory) {
+    return stored == factory || (stored->GetClassType() == factory->GetClassType() && *stored == *factory);
+}
+
+cppParser::InstanceTracker::ThreadScope::ThreadScope(InstanceTracker& tracker, std::unordered_set<std::string> classTypes) : tracker(tracker), classTypes(std::move(classTypes)) {
+    ActiveScopes().push_back(this);
+}
+
+cppParser::InstanceTracker::ThreadScope::~ThreadScope() {
+    auto& activeScopes = ActiveScopes();
+    activeScopes.erase(std::find(activeScopes.begin(), activeScopes.end(), this));
+}
+
+std::vector<cppParser::InstanceTracker::ThreadScope*>& cppParser::InstanceTracker::ThreadScope::ActiveScopes() {
+    static thread_local std::vector<ThreadScope*> activeScopes;
+    return activeScopes;
+}
+
+cppParser::InstanceTracker::ThreadScope* cppParser::InstanceTracker::ThreadScope::Find(const InstanceTracker& tracker, const std::string& classType) {
+    const auto& activeScopes = ActiveScopes();
+    for (auto scope = activeScopes.rbegin(); scope != activeScopes.rend(); ++scope) {
+        if (&(*scope)->tracker == &tracker && ((*scope)->classTypes.empty() || (*scope)->classTypes.count(classType))) {
+            return *scope;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t cppParser::InstanceTracker::InstanceKey(const std::shared_ptr<Factory>& factory) {
+    auto seed = factory->GetHash();
+    seed ^= std::hash<std::string>{}(factory->GetClassType()) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+cppParser::InstanceTracker& cppParser::InstanceTracker::GetOwner(const std::shared_ptr<Factory>& factory) const {
+    if (parent && factory->GetInstanceTracker() == parent) {
+        return *parent;
+    }
+    return const_cast<InstanceTracker&>(*this);
+}
+
 std::shared_ptr<void> cppParser::InstanceTracker::GetInstancePointer(const std::shared_ptr<Factory>& factory) const {
-    if (instances.count(factory->GetClassType())) {
-        auto classInstances = instances.at(factory->GetClassType());
-        for (const auto& [storedFactory, storedInstance] : classInstances) {
-            if (*storedFactory == *factory) {
-                return storedInstance;
+    if (auto& owner = GetOwner(factory); &owner != this) {
+        return owner.GetInstancePointer(factory);
+    }
+
+    const auto key = InstanceKey(factory);
+
+    if (auto scope = ThreadScope::Find(*this, factory->GetClassType())) {
+        auto range = scope->instances.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (IsSameFactory(it->second.factory, factory)) {
+                return it->second.instance;
+            }
+        }
+        return nullptr;
+    }
+
+    std::shared_future<std::shared_ptr<void>> storedInstance;
+    std::shared_ptr<void> instance;
+    {
+        const auto& shard = GetShard(key);
+        std::lock_guard lock(shard.mutex);
+        auto range = shard.instances.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (IsSameFactory(it->second.factory, factory)) {
+                if (it->second.instance.valid()) {
+                    storedInstance = it->second.instance;
+                } else if (!(instance = it->second.weakInstance.lock())) {
+                    expired++;
+                }
+                break;
+            }
+        }
+    }
+
+    // wait outside the lock in case the instance is still being created
+    if (storedInstance.valid()) {
+        instance = storedInstance.get();
+    }
+    if (instance) {
+        hits++;
+        Pin(instance);
+    } else {
+        misses++;
+    }
+    return instance;
+}
+
+void cppParser::InstanceTracker::Pin(const std::shared_ptr<void>& instance) const {
+    if (options.retention != InstanceRetention::Weak || options.pinnedCapacity == 0 || !instance) {
+        return;
+    }
+
+    std::lock_guard lock(pinnedMutex);
+    if (auto position = pinnedPositions.find(instance.get()); position != pinnedPositions.end()) {
+        pinned.splice(pinned.begin(), pinned, position->second);
+        return;
+    }
+    pinned.push_front(instance);
+    pinnedPositions.emplace(instance.get(), pinned.begin());
+    while (pinned.size() > options.pinnedCapacity) {
+        pinnedPositions.erase(pinned.back().get());
+        pinned.pop_back();
+        evictions++;
+    }
+}
+
+void cppParser::InstanceTracker::StoreCreatedInstance(Shard& shard, std::size_t key, const std::shared_ptr<Factory>& factory, const std::shared_ptr<void>& instance) {
+    if (options.retention != InstanceRetention::Weak) {
+        return;
+    }
+
+    std::lock_guard lock(shard.mutex);
+    auto range = shard.instances.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.factory == factory && it->second.instance.valid()) {
+            it->second.weakInstance = instance;
+            it->second.instance = {};
+            break;
+        }
+    }
+
+    // remove the released instances, the sweep size doubles with the live entries so the sweeps are amortized over the inserts
+    if (shard.instances.size() >= shard.sweepSize) {
+        for (auto it = shard.instances.begin(); it != shard.instances.end();) {
+            if (!it->second.instance.valid() && it->second.weakInstance.expired()) {
+                it = shard.instances.erase(it);
+            } else {
+                ++it;
             }
         }
+        shard.sweepSize = std::max(minimumSweepSize, shard.instances.size() * 2);
     }
-    return {};
 }
 
 void cppParser::InstanceTracker::SetInstancePointer(const std::shared_ptr<Factory>& factory, std::shared_ptr<void> instance) {
-    instances[factory->GetClassType()].emplace_back(std::make_pair(factory, instance));
+    if (auto& owner = GetOwner(factory); &owner != this) {
+        return owner.SetInstancePointer(factory, std::move(instance));
+    }
+
+    const auto key = InstanceKey(factory);
+    std::promise<std::shared_ptr<void>> promise;
+    promise.set_value(instance);
+
+    auto& shard = GetShard(key);
+    {
+        std::lock_guard lock(shard.mutex);
+        shard.instances.emplace(key, InstanceEntry{.factory = factory, .instance = promise.get_future().share(), .creator = std::this_thread::get_id()});
+    }
+    StoreCreatedInstance(shard, key, factory, instance);
+    Pin(instance);
+}
+
+std::pair<std::shared_ptr<void>, bool> cppParser::InstanceTracker::GetOrCreateScopedInstancePointer(ThreadScope& scope, const std::shared_ptr<Factory>& factory, std::size_t key,
+                                                                                                    const std::function<std::shared_ptr<void>()>& createInstance) {
+    auto range = scope.instances.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (IsSameFactory(it->second.factory, factory)) {
+            // an instance still being created on this thread can never complete
+            if (!it->second.instance) {
+                throw std::invalid_argument("circular dependency creating " + factory->GetClassType());
+            }
+            return std::make_pair(it->second.instance, false);
+        }
+    }
+
+    // reserve the entry, references (unlike iterators) stay valid while the nested creates add entries
+    auto& reserved = scope.instances.emplace(key, ScopeEntry{.factory = factory, .instance = nullptr})->second;
+    try {
+        reserved.instance = createInstance();
+        return std::make_pair(reserved.instance, true);
+    } catch (...) {
+        auto reservedRange = scope.instances.equal_range(key);
+        for (auto it = reservedRange.first; it != reservedRange.second; ++it) {
+            if (&it->second == &reserved) {
+                scope.instances.erase(it);
+                break;
+            }
+        }
+        throw;
+    }
+}
+
+std::pair<std::shared_ptr<void>, bool> cppParser::InstanceTracker::GetOrCreateInstancePointer(const std::shared_ptr<Factory>& factory,
+                                                                                              const std::function<std::shared_ptr<void>()>& createInstance) {
+    if (auto& owner = GetOwner(factory); &owner != this) {
+        return owner.GetOrCreateInstancePointer(factory, createInstance);
+    }
+
+    const auto key = InstanceKey(factory);
+
+    if (auto scope = ThreadScope::Find(*this, factory->GetClassType())) {
+        return GetOrCreateScopedInstancePointer(*scope, factory, key, createInstance);
+    }
+
+    auto& shard = GetShard(key);
+    std::promise<std::shared_ptr<void>> promise;
+    std::shared_future<std::shared_ptr<void>> storedInstance;
+    std::shared_ptr<void> liveInstance;
+    bool found = false;
+    bool reserved = false;
+    {
+        std::lock_guard lock(shard.mutex);
+        auto range = shard.instances.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (IsSameFactory(it->second.factory, factory)) {
+                if (!it->second.instance.valid()) {
+                    // a weakly held instance that was released is created again
+                    if ((liveInstance = it->second.weakInstance.lock())) {
+                        found = true;
+                    } else {
+                        expired++;
+                        shard.instances.erase(it);
+                    }
+                    break;
+                }
+                // an instance still being created by this thread can never complete.  The executor only runs the nested tasks of a create on top of it, so this is a
+                // circular dependency rather than an unrelated task that reached the same factory.
+                if (it->second.creator == std::this_thread::get_id() && it->second.instance.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    throw std::invalid_argument("circular dependency creating " + factory->GetClassType());
+                }
+                found = true;
+                storedInstance = it->second.instance;
+                break;
+            }
+        }
+
+        // reserve the entry so other threads wait for this instance
+        if (!found) {
+            shard.instances.emplace(key, InstanceEntry{.factory = factory, .instance = promise.get_future().share(), .creator = std::this_thread::get_id()});
+            reserved = true;
+        }
+    }
+
+    if (storedInstance.valid() || liveInstance) {
+        // the creating thread only waits on the instances its own create depends on, so waiting here cannot close a cycle
+        if (storedInstance.valid()) {
+            liveInstance = storedInstance.get();
+        }
+        hits++;
+        Pin(liveInstance);
+        return std::make_pair(std::move(liveInstance), false);
+    }
+
+    try {
+        misses++;
+        auto instance = createInstance();
+        if (reserved) {
+            promise.set_value(instance);
+            StoreCreatedInstance(shard, key, factory, instance);
+        }
+        Pin(instance);
+        return std::make_pair(std::move(instance), true);
+    } catch (...) {
+        if (reserved) {
+            // remove the reserved entry so the instance can be created again and pass the error to any waiting threads
+            {
+                std::lock_guard lock(shard.mutex);
+                auto range = shard.instances.equal_range(key);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second.factory == factory) {
+                        shard.instances.erase(it);
+                        break;
+                    }
+                }
+            }
+            promise.set_exception(std::current_exception());
+        }
+        throw;
+    }
 }
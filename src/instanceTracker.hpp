@@ -1,9 +1,18 @@
 #ifndef CPPPARSER_INSTANCETRACKER_HPP
 #define CPPPARSER_INSTANCETRACKER_HPP
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -12,16 +21,199 @@ namespace cppParser {
 class Factory;
 
 /**
- * Used to track and re use instances for the same factories
+ * How the InstanceTracker holds on to the instances it has created
+ */
+enum class InstanceRetention {
+    // every instance is kept for the life of the tracker
+    Strong,
+    // instances are held by weak_ptr and released once nothing else uses them, a later create makes a new instance
+    Weak
+};
+
+struct InstanceTrackerOptions {
+    InstanceRetention retention = InstanceRetention::Strong;
+
+    // with weak retention, the most recently used instances that are also held strongly so they outlive their callers.  Zero pins nothing.
+    std::size_t pinnedCapacity = 0;
+};
+
+/**
+ * Used to track and re use instances for the same factories.  The instances are split into shards by class type and factory hash, each with its own lock, so instances can be
+ * created and looked up concurrently.
  */
 class InstanceTracker {
    private:
-    std::map<std::string, std::vector<std::pair<std::shared_ptr<Factory>, std::shared_ptr<void>>>> instances;
+    /**
+     * The instance is stored as a future so that other threads can wait on an instance that is still being created
+     */
+    struct InstanceEntry {
+        std::shared_ptr<Factory> factory;
+        std::shared_future<std::shared_ptr<void>> instance;
+        // the thread creating the instance
+        std::thread::id creator;
+        // with weak retention the future is reset once the instance is created and only this weak reference is kept
+        std::weak_ptr<void> weakInstance;
+    };
+
+    /**
+     * The instances are keyed by the combined class type and factory hash, so SameFactory is only called on hash collisions.  Each shard is on its own cache line so the locks
+     * of neighbouring shards are not contended.
+     */
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_multimap<std::size_t, InstanceEntry> instances;
+        // with weak retention, the expired entries are removed when the shard grows to this size
+        std::size_t sweepSize = minimumSweepSize;
+    };
+
+    static constexpr std::size_t shardCount = 16;
+    static constexpr std::size_t minimumSweepSize = 64;
+    std::array<Shard, shardCount> shards;
+
+    const InstanceTrackerOptions options;
+
+    // instances of factories that use the parent tracker are created in the parent, i.e. the unchanged children of an overlay.  Nullptr when the tracker is not chained.
+    const std::shared_ptr<InstanceTracker> parent;
+
+    /**
+     * The pinned instances, most recently used first, and the position of each instance in the list
+     */
+    mutable std::mutex pinnedMutex;
+    mutable std::list<std::shared_ptr<void>> pinned;
+    mutable std::unordered_map<const void*, std::list<std::shared_ptr<void>>::iterator> pinnedPositions;
+
+    mutable std::atomic<std::size_t> hits = 0;
+    mutable std::atomic<std::size_t> misses = 0;
+    mutable std::atomic<std::size_t> evictions = 0;
+    mutable std::atomic<std::size_t> expired = 0;
+
+    /**
+     * The instances created on one thread while a ThreadScope is active.  Only that thread reads or writes the entries, so they are not locked.
+     */
+    struct ScopeEntry {
+        std::shared_ptr<Factory> factory;
+        // empty while the instance is being created
+        std::shared_ptr<void> instance;
+    };
+
+   public:
+    /**
+     * While a ThreadScope is alive on a thread, instances of the scoped class types created through the tracker on that thread are stored in the scope instead of the shared
+     * tracker.  Each worker thread then gets its own instance of a hot object, so the instance and its reference count are never shared between cores.  The instances are
+     * released when the scope is destroyed.  Scopes may be nested, the innermost scope for the tracker is used.  The scope must be destroyed on the thread that created it
+     * and before the tracker.  Scopes are not carried into executor tasks, so factories create their children on the scoped thread instead of in parallel.
+     */
+    class ThreadScope {
+       private:
+        InstanceTracker& tracker;
+
+        // the class types created per thread, every class type when empty
+        const std::unordered_set<std::string> classTypes;
+
+        std::unordered_multimap<std::size_t, ScopeEntry> instances;
+
+        friend class InstanceTracker;
+
+        /**
+         * The innermost scope for the tracker on this thread that holds the class type, nullptr when there is none
+         */
+        static ThreadScope* Find(const InstanceTracker& tracker, const std::string& classType);
+
+        /**
+         * The scopes alive on this thread, innermost last
+         */
+        static std::vector<ThreadScope*>& ActiveScopes();
+
+       public:
+        /**
+         * Start the scope on the current thread
+         * @param tracker
+         * @param classTypes the class types created once per thread, every class type when empty
+         */
+        explicit ThreadScope(InstanceTracker& tracker, std::unordered_set<std::string> classTypes = {});
+
+        ~ThreadScope();
+
+        ThreadScope(const ThreadScope&) = delete;
+        ThreadScope& operator=(const ThreadScope&) = delete;
+
+        /**
+         * True when a scope is alive on the current thread
+         */
+        static bool IsActive() { return !ActiveScopes().empty(); }
+
+        /**
+         * The number of instances created in this scope
+         */
+        [[nodiscard]] std::size_t Size() const { return instances.size(); }
+    };
+
+   private:
+    /**
+     * The key of the factory in the shards, the factory hash combined with the class type
+     */
+    static std::size_t InstanceKey(const std::shared_ptr<Factory>& factory);
+
+    /**
+     * The tracker that holds the instances of the factory, the parent when the factory uses it and otherwise this tracker
+     */
+    InstanceTracker& GetOwner(const std::shared_ptr<Factory>& factory) const;
+
+    inline Shard& GetShard(std::size_t key) { return shards[key % shardCount]; }
+    inline const Shard& GetShard(std::size_t key) const { return shards[key % shardCount]; }
+
+    /**
+     * Keep the instance in the pinned instances, evicting the least recently used instance when over capacity
+     */
+    void Pin(const std::shared_ptr<void>& instance) const;
+
+    /**
+     * Record the created instance in its reserved entry.  With weak retention, only a weak reference is kept and the shard is swept of expired entries as it grows.
+     */
+    void StoreCreatedInstance(Shard& shard, std::size_t key, const std::shared_ptr<Factory>& factory, const std::shared_ptr<void>& instance);
 
     std::shared_ptr<void> GetInstancePointer(const std::shared_ptr<Factory>& factory) const;
     void SetInstancePointer(const std::shared_ptr<Factory>& factory, std::shared_ptr<void>);
+    std::pair<std::shared_ptr<void>, bool> GetOrCreateInstancePointer(const std::shared_ptr<Factory>& factory, const std::function<std::shared_ptr<void>()>& createInstance);
+
+    /**
+     * Return the instance from the thread scope or create and store it
+     */
+    static std::pair<std::shared_ptr<void>, bool> GetOrCreateScopedInstancePointer(ThreadScope& scope, const std::shared_ptr<Factory>& factory, std::size_t key,
+                                                                                   const std::function<std::shared_ptr<void>()>& createInstance);
 
    public:
+    /**
+     * The use of the shared tracker, instances in a ThreadScope are not counted
+     */
+    struct Statistics {
+        // an existing instance was returned
+        std::size_t hits = 0;
+        // no instance was found, either by a lookup or before creating a new instance
+        std::size_t misses = 0;
+        // an instance was dropped from the pinned instances
+        std::size_t evictions = 0;
+        // a weakly held instance had already been released
+        std::size_t expired = 0;
+    };
+
+    /**
+     * @param options
+     * @param parent the tracker of the factories this tracker is layered over.  Instances of factories that use the parent are found and created in the parent, every
+     * other instance is held by this tracker.
+     */
+    explicit InstanceTracker(InstanceTrackerOptions options = {}, std::shared_ptr<InstanceTracker> parent = {}) : options(options), parent(std::move(parent)) {}
+
+    /**
+     * The hits, misses, evictions, and expired instances since the tracker was created
+     */
+    [[nodiscard]] Statistics GetStatistics() const {
+        return Statistics{.hits = hits.load(std::memory_order_relaxed),
+                          .misses = misses.load(std::memory_order_relaxed),
+                          .evictions = evictions.load(std::memory_order_relaxed),
+                          .expired = expired.load(std::memory_order_relaxed)};
+    }
+
     /**
      * Check to see if this factory has been used to create an instance before.  If so return it
      * @tparam Interface
@@ -38,13 +230,27 @@ class InstanceTracker {
     }
 
     /**
-     * Store the instance to this factory
+     * Store the instance to this factory in the shared tracker
      * @param factory
      */
     template <typename Interface>
     void SetInstance(const std::shared_ptr<Factory>& factory, std::shared_ptr<Interface> instance) {
         SetInstancePointer(factory, instance);
     }
+
+    /**
+     * Return the instance for this factory or create and store it.  Only one thread creates the instance for the same factory, other threads wait for the result.  When a
+     * ThreadScope for the class type is active on this thread, the instance is only shared within that scope.  Throws an invalid_argument when the instance depends on itself.
+     * @tparam Interface
+     * @param factory
+     * @param createInstance
+     * @return the instance and true if it was created by this call
+     */
+    template <typename Interface>
+    std::pair<std::shared_ptr<Interface>, bool> GetOrCreateInstance(const std::shared_ptr<Factory>& factory, const std::function<std::shared_ptr<Interface>()>& createInstance) {
+        auto [instance, created] = GetOrCreateInstancePointer(factory, [&createInstance]() -> std::shared_ptr<void> { return createInstance(); });
+        return std::make_pair(std::static_pointer_cast<Interface>(instance), created);
+    }
 };
 }  // namespace cppParser
 
@@ -0,0 +1,368 @@
+#include "lazyYamlNode.hpp"
+#include <optional>
+#include <vector>
+
+namespace cppParser {
+
+/**
+ * A line based scan of the block mappings in the yaml text.  Anything that cannot be split safely on lines (anchors, aliases, complex or quoted keys, tabs, ...) stops the
+ * scan so that the document is parsed normally.
+ */
+class LazyYamlScanner {
+   private:
+    struct Line {
+        std::size_t begin;
+        std::size_t next;
+        int indent;
+        std::string_view content;
+        bool blank;
+    };
+
+    std::vector<Line> lines;
+
+    static inline bool IsBlank(char c) { return c == ' ' || c == '\t'; }
+
+    static std::string_view Trim(std::string_view value) {
+        while (!value.empty() && IsBlank(value.front())) {
+            value.remove_prefix(1);
+        }
+        while (!value.empty() && IsBlank(value.back())) {
+            value.remove_suffix(1);
+        }
+        return value;
+    }
+
+    static bool IsDocumentMarker(const Line& line) {
+        return line.indent == 0 && line.content.size() >= 3 && (line.content.substr(0, 3) == "---" || line.content.substr(0, 3) == "...") &&
+               (line.content.size() == 3 || IsBlank(line.content[3]));
+    }
+
+    static bool IsSequenceLine(const Line& line) { return !line.content.empty() && line.content[0] == '-' && (line.content.size() == 1 || IsBlank(line.content[1])); }
+
+    /**
+     * Split a "key: rest" line, only plain keys are accepted
+     */
+    static bool SplitKeyLine(const Line& line, std::string_view& key, std::string_view& rest) {
+        const auto& content = line.content;
+        if (content.empty() || std::string_view("-?[]{},\"'!&*|>%@`#").find(content[0]) != std::string_view::npos) {
+            return false;
+        }
+        for (std::size_t i = 0; i < content.size(); i++) {
+            if (content[i] == '#' && IsBlank(content[i - 1])) {
+                return false;
+            }
+            if (content[i] == ':' && (i + 1 == content.size() || IsBlank(content[i + 1]))) {
+                key = Trim(content.substr(0, i));
+                rest = content.substr(i + 1);
+                // drop any comment after the value
+                for (std::size_t c = 0; c < rest.size(); c++) {
+                    if (rest[c] == '#' && (c == 0 || IsBlank(rest[c - 1]))) {
+                        rest = rest.substr(0, c);
+                        break;
+                    }
+                }
+                rest = Trim(rest);
+                return !key.empty();
+            }
+        }
+        return false;
+    }
+
+    /**
+     * A value that is empty or only a local tag can be followed by a nested block mapping
+     */
+    static bool IsEmptyOrTag(std::string_view rest) {
+        return rest.empty() || (rest[0] == '!' && rest.find_first_of(" \t") == std::string_view::npos && rest.substr(0, 2) != "!!" && rest.substr(0, 2) != "!<");
+    }
+
+    std::size_t SkipBlankLines(std::size_t i) const {
+        while (i < lines.size() && lines[i].blank) {
+            i++;
+        }
+        return i;
+    }
+
+   public:
+    /**
+     * Split the text into lines, returns false if the text cannot be scanned
+     */
+    bool SplitLines(std::string_view text) {
+        // anchors and aliases can reference nodes across entries so they need the full document
+        for (std::size_t i = 0; i < text.size(); i++) {
+            if ((text[i] == '&' || text[i] == '*') && (i == 0 || std::string_view(" \t\r\n[{,").find(text[i - 1]) != std::string_view::npos)) {
+                return false;
+            }
+        }
+
+        std::size_t begin = 0;
+        while (begin < text.size()) {
+            auto end = text.find('\n', begin);
+            auto next = end == std::string_view::npos ? text.size() : end + 1;
+            end = end == std::string_view::npos ? text.size() : end;
+            if (end > begin && text[end - 1] == '\r') {
+                end--;
+            }
+
+            auto indent = begin;
+            while (indent < end && text[indent] == ' ') {
+                indent++;
+            }
+            auto content = text.substr(indent, end - indent);
+            bool blank = Trim(content).empty() || Trim(content)[0] == '#';
+            if (!blank && IsBlank(content[0])) {
+                // tabs cannot be used for indentation
+                return false;
+            }
+            lines.push_back(Line{.begin = begin, .next = next, .indent = (int)(indent - begin), .content = content, .blank = blank});
+            begin = next;
+        }
+        return true;
+    }
+
+    /**
+     * Scan the block mapping at the indent starting at the line
+     * @return the line after the mapping or empty if the mapping cannot be read lazily
+     */
+    std::optional<std::size_t> ScanMapping(std::size_t i, int indent, LazyYamlNode& node) const {
+        while (true) {
+            i = SkipBlankLines(i);
+            if (i == lines.size() || lines[i].indent < indent || IsDocumentMarker(lines[i])) {
+                return i;
+            }
+            const auto& line = lines[i];
+            std::string_view key, rest;
+            if (line.indent > indent || !SplitKeyLine(line, key, rest) || node.index.count(key)) {
+                return {};
+            }
+
+            auto& entry = node.entries.emplace_back(std::string(key), line.begin, i, line.indent);
+            node.index.emplace(entry.key, &entry);
+
+            auto valueLine = SkipBlankLines(i + 1);
+            std::string_view childKey, childRest;
+            if (IsEmptyOrTag(rest) && valueLine < lines.size() && lines[valueLine].indent > indent && SplitKeyLine(lines[valueLine], childKey, childRest)) {
+                // a nested block mapping
+                entry.tag = rest;
+                entry.children = std::shared_ptr<LazyYamlNode>(new LazyYamlNode(node.source));
+                auto next = ScanMapping(valueLine, lines[valueLine].indent, *entry.children);
+                if (!next) {
+                    return {};
+                }
+                i = *next;
+            } else {
+                // the value is every following line indented more than the key, or a sequence at the same indent
+                auto last = i;
+                for (auto j = i + 1; j < lines.size(); j++) {
+                    if (lines[j].blank) {
+                        continue;
+                    }
+                    if (lines[j].indent > indent || (rest.empty() && lines[j].indent == indent && IsSequenceLine(lines[j]))) {
+                        last = j;
+                    } else {
+                        break;
+                    }
+                }
+                i = last + 1;
+            }
+            entry.end = lines[i - 1].next;
+        }
+    }
+
+    /**
+     * Find the first line of the root mapping
+     * @return the line or empty if the document is not a block mapping
+     */
+    std::optional<std::size_t> FindRoot() const {
+        auto i = SkipBlankLines(0);
+        if (i < lines.size() && IsDocumentMarker(lines[i])) {
+            // the document start must be on its own line
+            if (lines[i].content.substr(0, 3) != "---" || !Trim(lines[i].content.substr(3)).empty()) {
+                return {};
+            }
+            i = SkipBlankLines(i + 1);
+        }
+        std::string_view key, rest;
+        if (i == lines.size() || !SplitKeyLine(lines[i], key, rest)) {
+            return {};
+        }
+        return i;
+    }
+
+    [[nodiscard]] bool IsDocumentEnd(std::size_t i) const { return i == lines.size() || IsDocumentMarker(lines[i]); }
+
+    [[nodiscard]] const Line& GetLine(std::size_t i) const { return lines[i]; }
+};
+
+}  // namespace cppParser
+
+std::shared_ptr<const cppParser::LazyYamlNode> cppParser::LazyYamlNode::Scan(std::shared_ptr<const void> owner, std::string_view text, YAML::Node& root) {
+    LazyYamlScanner scanner;
+    if (!scanner.SplitLines(text)) {
+        return nullptr;
+    }
+    auto rootLine = scanner.FindRoot();
+    if (!rootLine) {
+        return nullptr;
+    }
+
+    auto source = std::make_shared<Source>();
+    source->owner = std::move(owner);
+    source->text = text;
+    auto lazyNode = std::shared_ptr<LazyYamlNode>(new LazyYamlNode(source));
+
+    // only a following document may come after the root mapping
+    auto end = scanner.ScanMapping(*rootLine, scanner.GetLine(*rootLine).indent, *lazyNode);
+    if (!end || !scanner.IsDocumentEnd(*end)) {
+        return nullptr;
+    }
+
+    root = YAML::Node(YAML::NodeType::Map);
+    lazyNode->AddPlaceholders(root, "");
+    return lazyNode;
+}
+
+void cppParser::LazyYamlNode::AddPlaceholders(YAML::Node& mapping, const std::string& tag) const {
+    // match the non specific tag that yaml-cpp gives untagged mappings and plain keys
+    mapping.SetTag(tag.empty() ? "?" : tag);
+    for (const auto& entry : entries) {
+        YAML::Node key(entry.key);
+        key.SetTag("?");
+        mapping.force_insert(key, YAML::Node(YAML::NodeType::Null));
+    }
+}
+
+void cppParser::LazyYamlNode::Materialize(const Entry& entry, YAML::Node node) const {
+    if (entry.materialized.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // yaml-cpp nodes in the same document share memory, so only one entry is materialized at a time
+    std::lock_guard<std::mutex> lock(source->mutex);
+    if (entry.materialized.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    YAML::Node value;
+    if (entry.children) {
+        value = YAML::Node(YAML::NodeType::Map);
+        entry.children->AddPlaceholders(value, entry.tag);
+    } else {
+        // the range holds the whole "key: value" entry
+        YAML::Node mapping;
+        try {
+            mapping = YAML::Load(std::string(source->text.substr(entry.begin, entry.end - entry.begin)));
+        } catch (const YAML::ParserException& exception) {
+            throw YAML::ParserException(ShiftMark(entry, exception.mark), exception.msg);
+        }
+        value = mapping.begin()->second;
+    }
+
+    // assigning to the placeholder handle replaces the placeholder for every handle to it
+    node = value;
+    entry.materialized.store(true, std::memory_order_release);
+}
+
+void cppParser::LazyYamlNode::Materialize(const std::string& key, const YAML::Node& node, bool recursive) const {
+    auto entry = index.find(key);
+    if (entry == index.end()) {
+        return;
+    }
+    Materialize(*entry->second, node);
+    if (recursive && entry->second->children) {
+        entry->second->children->MaterializeAll(node);
+    }
+}
+
+void cppParser::LazyYamlNode::MaterializeAll(const YAML::Node& node) const {
+    for (const auto& child : node) {
+        if (child.first.IsScalar()) {
+            Materialize(child.first.Scalar(), child.second, true);
+        }
+    }
+}
+
+std::shared_ptr<const cppParser::LazyYamlNode> cppParser::LazyYamlNode::GetChild(const std::string& key) const {
+    auto entry = index.find(key);
+    return entry != index.end() ? entry->second->children : nullptr;
+}
+
+YAML::Mark cppParser::LazyYamlNode::ShiftMark(const Entry& entry, YAML::Mark mark) {
+    // the entry starts at the beginning of a line so the column is unchanged
+    if (!mark.is_null()) {
+        mark.pos += (int)entry.begin;
+        mark.line += (int)entry.line;
+    }
+    return mark;
+}
+
+YAML::Mark cppParser::LazyYamlNode::KeyMark(const Entry& entry) {
+    YAML::Mark mark;
+    mark.pos = (int)entry.begin + entry.column;
+    mark.line = (int)entry.line;
+    mark.column = entry.column;
+    return mark;
+}
+
+YAML::Mark cppParser::LazyYamlNode::GetMark(const Entry& entry) const {
+    if (entry.tag.empty()) {
+        return KeyMark(entry.children->entries.front());
+    }
+    YAML::Mark mark;
+    mark.pos = (int)source->text.find(entry.tag, entry.begin + entry.column + entry.key.size());
+    mark.line = (int)entry.line;
+    mark.column = (int)(mark.pos - entry.begin);
+    return mark;
+}
+
+/**
+ * Check if the node is the tree or one of its descendants
+ */
+static bool ContainsNode(const YAML::Node& tree, const YAML::Node& node) {
+    if (tree.is(node)) {
+        return true;
+    }
+    if (tree.IsSequence()) {
+        for (const auto& item : tree) {
+            if (ContainsNode(item, node)) {
+                return true;
+            }
+        }
+    } else if (tree.IsMap()) {
+        for (const auto& item : tree) {
+            if (ContainsNode(item.first, node) || ContainsNode(item.second, node)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::optional<YAML::Mark> cppParser::LazyYamlNode::FindMark(const YAML::Node& mapping, const YAML::Node& node) const {
+    // the nodes are not changed while searching
+    std::lock_guard<std::mutex> lock(source->mutex);
+    if (mapping.is(node) && !entries.empty()) {
+        // the root mapping is marked at its first key
+        return KeyMark(entries.front());
+    }
+    return FindMarkInMapping(mapping, node);
+}
+
+std::optional<YAML::Mark> cppParser::LazyYamlNode::FindMarkInMapping(const YAML::Node& mapping, const YAML::Node& node) const {
+    for (const auto& child : mapping) {
+        auto entry = child.first.IsScalar() ? index.find(child.first.Scalar()) : index.end();
+        if (entry == index.end() || !entry->second->materialized.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (entry->second->children) {
+            if (child.second.is(node)) {
+                return GetMark(*entry->second);
+            }
+            if (auto mark = entry->second->children->FindMarkInMapping(child.second, node)) {
+                return mark;
+            }
+        } else if (ContainsNode(child.second, node)) {
+            return ShiftMark(*entry->second, node.Mark());
+        }
+    }
+    return {};
+}
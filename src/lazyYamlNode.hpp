@@ -0,0 +1,124 @@
+#ifndef CPPPARSER_LAZYYAMLNODE_HPP
+#define CPPPARSER_LAZYYAMLNODE_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace cppParser {
+
+/**
+ * The byte ranges of the entries in a block mapping, recorded by a fast structural scan of the yaml text.  The yaml node for the mapping holds a null placeholder for each
+ * entry until the entry is materialized.  Nested block mappings are materialized one level at a time, every other value is parsed with yaml-cpp from its byte range.
+ */
+class LazyYamlNode {
+   private:
+    /**
+     * The yaml text shared by every node in the document.  The mutex guards the yaml-cpp nodes while they are materialized.
+     */
+    struct Source {
+        std::shared_ptr<const void> owner;
+        std::string_view text;
+        std::mutex mutex;
+    };
+
+    struct Entry {
+        std::string key;
+        std::size_t begin;
+        std::size_t end;
+        // the zero based line and column of the key
+        std::size_t line;
+        int column;
+        // the tag of a nested block mapping
+        std::string tag;
+        std::shared_ptr<LazyYamlNode> children;
+        mutable std::atomic<bool> materialized = false;
+
+        Entry(std::string key, std::size_t begin, std::size_t line, int column) : key(std::move(key)), begin(begin), end(begin), line(line), column(column) {}
+    };
+
+    const std::shared_ptr<Source> source;
+
+    // the entries in document order, the deque keeps the index keys valid
+    std::deque<Entry> entries;
+    std::unordered_map<std::string_view, const Entry*> index;
+
+    explicit LazyYamlNode(std::shared_ptr<Source> source) : source(std::move(source)) {}
+
+    // the scanner records the entries
+    friend class LazyYamlScanner;
+
+    /**
+     * Add a null placeholder to the mapping for each entry
+     */
+    void AddPlaceholders(YAML::Node& mapping, const std::string& tag) const;
+
+    void Materialize(const Entry& entry, YAML::Node node) const;
+
+    /**
+     * The mark of a node parsed from the entry is relative to the start of the entry
+     */
+    static YAML::Mark ShiftMark(const Entry& entry, YAML::Mark mark);
+
+    /**
+     * The position of the entry key
+     */
+    static YAML::Mark KeyMark(const Entry& entry);
+
+    /**
+     * The position of a nested block mapping, yaml-cpp marks a mapping at its tag or first key
+     */
+    YAML::Mark GetMark(const Entry& entry) const;
+
+    std::optional<YAML::Mark> FindMarkInMapping(const YAML::Node& mapping, const YAML::Node& node) const;
+
+   public:
+    /**
+     * Scan the yaml text.  When the text is a single block mapping without anchors or aliases, the root is set to a map of placeholders and the lazy node is returned.
+     * Otherwise nullptr is returned and the text should be fully parsed.
+     * @param owner keeps the text alive
+     * @param text
+     * @param root
+     * @return
+     */
+    static std::shared_ptr<const LazyYamlNode> Scan(std::shared_ptr<const void> owner, std::string_view text, YAML::Node& root);
+
+    /**
+     * Replace the placeholder for the key with its value
+     * @param key
+     * @param node the placeholder in the mapping
+     * @param recursive materialize every nested mapping as well
+     */
+    void Materialize(const std::string& key, const YAML::Node& node, bool recursive) const;
+
+    /**
+     * Materialize every entry in the mapping
+     * @param node the mapping
+     */
+    void MaterializeAll(const YAML::Node& node) const;
+
+    /**
+     * The lazy node for a nested block mapping or nullptr when the value is fully parsed
+     * @param key
+     * @return
+     */
+    std::shared_ptr<const LazyYamlNode> GetChild(const std::string& key) const;
+
+    /**
+     * The position in the yaml text of a node materialized from this mapping.  The marks of the materialized nodes count lines from the start of their entry, and the
+     * nested mappings have no mark, so this is used to report errors at the same position as a full parse.
+     * @param mapping the node for this mapping
+     * @param node
+     * @return the mark or empty when the node is not in the mapping
+     */
+    std::optional<YAML::Mark> FindMark(const YAML::Node& mapping, const YAML::Node& node) const;
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_LAZYYAMLNODE_HPP
@@ -1,14 +1,62 @@
 #include "listing.hpp"
 
+/**
+ * An entry recorded before the listing is first read, the builder and the record it is built from
+ */
+template <typename Entry>
+struct DeferredListing {
+    Entry (*entryBuilder)(const void *);
+    std::shared_ptr<const void> record;
+};
+
+/**
+ * The entries recorded before the listing is first read.  Like the registrations themselves, these are recorded during static initialization.
+ */
+struct DeferredListings {
+    std::vector<DeferredListing<cppParser::Listing::ClassEntry>> entries;
+    std::vector<DeferredListing<cppParser::Listing::DerivedEntry>> derivedEntries;
+};
+
+static DeferredListings &GetDeferredListings() {
+    static auto deferredListings = new DeferredListings();
+    return *deferredListings;
+}
+
 void cppParser::Listing::RecordListing(cppParser::Listing::ClassEntry entry) { entries[entry.interface].push_back(std::move(entry)); }
 
 void cppParser::Listing::RecordListing(cppParser::Listing::DerivedEntry entry) { derivedEntries[entry.interface].push_back(std::move(entry)); }
 
+void cppParser::Listing::RecordDeferredListing(ClassEntry (*entryBuilder)(const void *), std::shared_ptr<const void> record) {
+    if (listing) {
+        listing->RecordListing(entryBuilder(record.get()));
+    } else {
+        GetDeferredListings().entries.push_back({entryBuilder, std::move(record)});
+    }
+}
+
+void cppParser::Listing::RecordDeferredListing(DerivedEntry (*entryBuilder)(const void *), std::shared_ptr<const void> record) {
+    if (listing) {
+        listing->RecordListing(entryBuilder(record.get()));
+    } else {
+        GetDeferredListings().derivedEntries.push_back({entryBuilder, std::move(record)});
+    }
+}
+
 cppParser::Listing &cppParser::Listing::Get() {
     if (listing == nullptr) {
         listing = std::shared_ptr<Listing>(new Listing());
     }
 
+    // build and record the deferred entries in registration order, then release the records
+    auto &deferredListings = GetDeferredListings();
+    for (const auto &deferred : deferredListings.entries) {
+        listing->RecordListing(deferred.entryBuilder(deferred.record.get()));
+    }
+    for (const auto &deferred : deferredListings.derivedEntries) {
+        listing->RecordListing(deferred.entryBuilder(deferred.record.get()));
+    }
+    deferredListings = DeferredListings();
+
     return *listing;
 }
 
@@ -49,7 +49,21 @@ class Listing {
      */
     virtual void RecordListing(DerivedEntry entry);
 
-    // get the singleton instance
+    /**
+     * record a listing that is only built when the listing is first read.  Once the listing has been read (or replaced) the entry is built and recorded immediately.
+     * @param entryBuilder builds the entry from the record
+     * @param record the registration details, released once the entry is built
+     */
+    static void RecordDeferredListing(ClassEntry (*entryBuilder)(const void *), std::shared_ptr<const void> record);
+
+    /**
+     * record a derived listing that is only built when the listing is first read
+     * @param entryBuilder builds the entry from the record
+     * @param record the registration details, released once the entry is built
+     */
+    static void RecordDeferredListing(DerivedEntry (*entryBuilder)(const void *), std::shared_ptr<const void> record);
+
+    // get the singleton instance, any deferred entries are recorded first
     static Listing &Get();
 
     Listing(Listing &other) = delete;
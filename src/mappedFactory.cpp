@@ -0,0 +1,240 @@
+#include "mappedFactory.hpp"
+#include <sstream>
+#include <utility>
+#include "inSituYamlReader.hpp"
+
+cppParser::MappedFactory::MappedFactory(std::shared_ptr<const FlatDocument> document, std::uint32_t node, std::string nodePath, std::string type,
+                                        std::vector<std::filesystem::path> searchDirectories, std::weak_ptr<InstanceTracker> instanceTracker)
+    : Factory(std::move(instanceTracker)),
+      document(std::move(document)),
+      node(node),
+      type(std::move(type)),
+      nodePath(std::move(nodePath)),
+      searchDirectories(std::move(searchDirectories)) {
+    // store each child in the map with zero usages
+    const auto& flatNode = this->document->GetNode(node);
+    if (flatNode.type == FlatNodeType::Map) {
+        for (auto entry = this->document->BeginEntries(flatNode); entry != this->document->EndEntries(flatNode); ++entry) {
+            nodeUsages.try_emplace(std::string(this->document->GetKey(*entry)), 0);
+        }
+    }
+}
+
+cppParser::MappedFactory::MappedFactory(std::shared_ptr<const FlatDocument> document, std::vector<std::filesystem::path> searchDirectories)
+    : MappedFactory(document, document->GetRoot(), "root", "", std::move(searchDirectories), {}) {
+    // create the root instance of the tracker
+    rootInstanceTracker = std::make_shared<InstanceTracker>();
+    instanceTracker = rootInstanceTracker;
+}
+
+cppParser::MappedFactory::MappedFactory(const std::filesystem::path& filePath, MappedFileFormat format)
+    : MappedFactory(format == MappedFileFormat::Yaml ? InSituYamlReader::Read(filePath) : FlatDocument::Map(filePath), {filePath.parent_path()}) {}
+
+std::optional<std::uint32_t> cppParser::MappedFactory::FindChild(const std::string& name) const {
+    const auto& flatNode = document->GetNode(node);
+    if (flatNode.type != FlatNodeType::Map) {
+        return {};
+    }
+
+    if (flatNode.entryCount > keyIndexThreshold) {
+        if (keyIndex.empty()) {
+            // keep only the first of any duplicate keys
+            for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+                keyIndex.try_emplace(document->GetKey(*entry), entry->node);
+            }
+        }
+        if (auto it = keyIndex.find(name); it != keyIndex.end()) {
+            return it->second;
+        }
+    } else {
+        for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+            if (document->GetKey(*entry) == name) {
+                return entry->node;
+            }
+        }
+    }
+    return {};
+}
+
+YAML::Node cppParser::MappedFactory::ToYaml(std::uint32_t valueNode) const {
+    const auto& flatNode = document->GetNode(valueNode);
+    switch (flatNode.type) {
+        case FlatNodeType::Scalar:
+            return YAML::Node(std::string(document->GetScalar(flatNode)));
+        case FlatNodeType::Sequence: {
+            YAML::Node sequence(YAML::NodeType::Sequence);
+            for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+                sequence.push_back(ToYaml(entry->node));
+            }
+            return sequence;
+        }
+        case FlatNodeType::Map: {
+            YAML::Node map(YAML::NodeType::Map);
+            for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+                map[std::string(document->GetKey(*entry))] = ToYaml(entry->node);
+            }
+            return map;
+        }
+        default:
+            return YAML::Node(YAML::NodeType::Null);
+    }
+}
+
+std::string cppParser::MappedFactory::Get(const ArgumentIdentifier<std::string>& identifier) const {
+    auto parameter = GetParameter(identifier);
+    if (!parameter) {
+        if (identifier.optional) {
+            return {};
+        } else {
+            throw std::invalid_argument("unable to locate " + identifier.inputName + " in " + nodePath);
+        }
+    }
+    MarkUsage(identifier.inputName);
+
+    const auto& flatNode = document->GetNode(*parameter);
+    if (flatNode.type == FlatNodeType::Sequence) {
+        // Merge the results into a single space separated string
+        std::stringstream ss;
+        for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+            ss << Convert<std::string>(entry->node) << " ";
+        }
+        return ss.str();
+    } else if (flatNode.type == FlatNodeType::Scalar) {
+        return std::string(document->GetScalar(flatNode));
+    } else {
+        return Convert<std::string>(*parameter);
+    }
+}
+
+std::shared_ptr<cppParser::Factory> cppParser::MappedFactory::GetFactory(const std::string& name) const {
+    // Check to see if the child factory has already been created
+    if (auto childFactory = childFactories.find(name); childFactory != childFactories.end()) {
+        return childFactory->second;
+    }
+
+    if (name.empty()) {
+        // Mark all children here on used, because they will be counted in the child
+        MarkAllUsed();
+        MarkUsage(name);
+        return childFactories[name] = std::shared_ptr<MappedFactory>(new MappedFactory(document, node, nodePath, "", searchDirectories, instanceTracker));
+    } else {
+        auto parameter = FindChild(name);
+        if (!parameter) {
+            throw std::invalid_argument("unable to find item " + name + " in " + nodePath);
+        }
+
+        // Remove the ! or ? from the tag
+        auto tagType = document->GetTag(document->GetNode(*parameter));
+        tagType = !tagType.empty() ? tagType.substr(1) : tagType;
+
+        // mark usage and store pointer
+        MarkUsage(name);
+        return childFactories[name] = std::shared_ptr<MappedFactory>(new MappedFactory(document, *parameter, nodePath + "/" + name, std::string(tagType), searchDirectories, instanceTracker));
+    }
+}
+
+std::vector<std::shared_ptr<cppParser::Factory>> cppParser::MappedFactory::GetFactorySequence(const std::string& name) const {
+    auto parameter = name.empty() ? std::optional<std::uint32_t>(node) : FindChild(name);
+    if (!parameter) {
+        throw std::invalid_argument("unable to find list " + name + " in " + nodePath);
+    }
+
+    const auto& flatNode = document->GetNode(*parameter);
+    if (flatNode.type != FlatNodeType::Sequence) {
+        throw std::invalid_argument("item " + name + " is expected to be a sequence in " + nodePath);
+    }
+
+    std::vector<std::shared_ptr<Factory>> children;
+
+    // march over each child
+    std::size_t i = 0;
+    for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+        std::string childName = name + "/" + std::to_string(i++);
+
+        auto& childFactory = childFactories[childName];
+        if (!childFactory) {
+            // Remove the ! or ? from the tag
+            auto tagType = document->GetTag(document->GetNode(entry->node));
+            tagType = !tagType.empty() ? tagType.substr(1) : tagType;
+
+            childFactory = std::shared_ptr<MappedFactory>(new MappedFactory(document, entry->node, nodePath + "/" + childName, std::string(tagType), searchDirectories, instanceTracker));
+        }
+
+        children.push_back(childFactory);
+    }
+
+    MarkUsage(name);
+
+    return children;
+}
+
+bool cppParser::MappedFactory::Contains(const std::string& name) const {
+    auto child = FindChild(name);
+    return child && document->GetNode(*child).type != FlatNodeType::Null;
+}
+
+std::unordered_set<std::string> cppParser::MappedFactory::GetKeys() const {
+    std::unordered_set<std::string> keys;
+
+    const auto& flatNode = document->GetNode(node);
+    if (flatNode.type == FlatNodeType::Map) {
+        for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+            keys.insert(std::string(document->GetKey(*entry)));
+        }
+    }
+
+    return keys;
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<cppParser::Factory>>> cppParser::MappedFactory::GetFactoryEntries() const {
+    std::vector<std::pair<std::string, std::shared_ptr<Factory>>> entries;
+
+    const auto& flatNode = document->GetNode(node);
+    if (flatNode.type == FlatNodeType::Map) {
+        entries.reserve(flatNode.entryCount);
+        std::unordered_set<std::string_view> visited;
+        for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+            const auto key = document->GetKey(*entry);
+            if (visited.insert(key).second) {
+                entries.emplace_back(std::string(key), GetFactory(std::string(key)));
+            }
+        }
+    }
+
+    return entries;
+}
+
+std::vector<std::string> cppParser::MappedFactory::GetUnusedValues() const {
+    std::vector<std::string> unused;
+
+    for (const auto& children : nodeUsages) {
+        if (children.second == 0) {
+            unused.push_back(nodePath + "/" + children.first);
+        }
+    }
+
+    // Add any unused children from used children
+    for (const auto& childFactory : childFactories) {
+        auto unusedChildren = childFactory.second->GetUnusedValues();
+        unused.insert(std::end(unused), std::begin(unusedChildren), std::end(unusedChildren));
+    }
+
+    return unused;
+}
+
+bool cppParser::MappedFactory::SameFactory(const Factory& otherFactory) const {
+    const auto otherFactoryPtr = dynamic_cast<const MappedFactory*>(&otherFactory);
+    return otherFactoryPtr && document == otherFactoryPtr->document && node == otherFactoryPtr->node;
+}
+
+std::size_t cppParser::MappedFactory::GetHash() const { return std::hash<const void*>{}(document.get()) ^ std::hash<std::uint32_t>{}(node); }
+
+std::filesystem::path cppParser::MappedFactory::Get(const cppParser::ArgumentIdentifier<std::filesystem::path>& identifier) const {
+    if (identifier.optional && !Contains(identifier.inputName)) {
+        return {};
+    }
+
+    // get the file locator instance
+    auto fileLocator = GetByName<cppParser::PathLocator>(identifier.inputName);
+    return fileLocator->Locate(searchDirectories);
+}
@@ -0,0 +1,281 @@
+#ifndef CPPPARSER_MAPPEDFACTORY_HPP
+#define CPPPARSER_MAPPEDFACTORY_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "factory.hpp"
+#include "flatDocument.hpp"
+#include "numericConverter.hpp"
+
+namespace cppParser {
+
+/**
+ * The format of the file read by a MappedFactory
+ */
+enum class MappedFileFormat {
+    // a binary config file written by the BinarySerializer
+    Binary,
+    // a yaml file read in place by the InSituYamlReader
+    Yaml
+};
+
+/**
+ * A factory that answers directly from a flat document, i.e. a memory mapped binary config file written by the BinarySerializer or a yaml file read in place.  The class types,
+ * node paths, and usage tracking match the YamlParser.
+ */
+class MappedFactory : public Factory {
+   private:
+    const std::shared_ptr<const FlatDocument> document;
+    const std::uint32_t node;
+    const std::string type;
+    const std::string nodePath;
+    const std::vector<std::filesystem::path> searchDirectories;
+    mutable std::map<std::string, int> nodeUsages;
+    mutable std::map<std::string, std::shared_ptr<MappedFactory>> childFactories;
+
+    // The root MappedFactory should store a shared ptr to the instance tracker
+    std::shared_ptr<InstanceTracker> rootInstanceTracker;
+
+    /**
+     * An index from the key to the child node, only built for large maps
+     */
+    mutable std::unordered_map<std::string_view, std::uint32_t> keyIndex;
+
+    /**
+     * Maps with up to this many keys are searched directly instead of building the keyIndex
+     */
+    static constexpr std::size_t keyIndexThreshold = 16;
+
+    /***
+     * private constructor to create a sub factory
+     */
+    MappedFactory(std::shared_ptr<const FlatDocument> document, std::uint32_t node, std::string nodePath, std::string type, std::vector<std::filesystem::path> searchDirectories,
+                  std::weak_ptr<InstanceTracker> instanceTracker);
+
+    inline void MarkUsage(const std::string& key) const {
+        if (auto usage = nodeUsages.find(key); usage != nodeUsages.end()) {
+            usage->second++;
+        }
+    }
+
+    /**
+     * Find the named child of this map
+     * @param name
+     * @return the child node or empty
+     */
+    std::optional<std::uint32_t> FindChild(const std::string& name) const;
+
+    /**
+     * Copy a single value into a yaml node so that values are converted exactly like the YamlParser
+     */
+    YAML::Node ToYaml(std::uint32_t valueNode) const;
+
+    /**
+     * Marks all of the keys used.
+     */
+    void MarkAllUsed() const override {
+        for (auto& pairs : nodeUsages) {
+            pairs.second++;
+        }
+    }
+
+    /**
+     * Convert numbers directly from the document scalars
+     * @return false if the value should be converted by yaml-cpp
+     */
+    template <typename T>
+    bool TryConvert(std::uint32_t valueNode, T& value) const {
+        const auto& flatNode = document->GetNode(valueNode);
+        if constexpr (std::is_arithmetic_v<T>) {
+            return flatNode.type == FlatNodeType::Scalar && NumericConverter::TryParse(document->GetScalar(flatNode), value);
+        } else {
+            if (flatNode.type != FlatNodeType::Sequence) {
+                return false;
+            }
+            value.reserve(flatNode.entryCount);
+            for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+                if (!TryConvert(entry->node, value.emplace_back())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    /**
+     * The type of the sequence items or map values checked when locating a conversion error
+     */
+    template <typename T>
+    struct ElementType {
+        using type = void;
+    };
+
+    template <typename T>
+    struct ElementType<std::vector<T>> {
+        using type = T;
+    };
+
+    template <typename T>
+    struct ElementType<std::map<std::string, T>> {
+        using type = T;
+    };
+
+    /**
+     * Throw the yaml-cpp conversion error at the position of the node that could not be converted, so the message matches the YamlParser
+     */
+    template <typename T>
+    [[noreturn]] void ThrowBadConversion(std::uint32_t valueNode) const {
+        const auto& flatNode = document->GetNode(valueNode);
+        if constexpr (!std::is_void_v<typename ElementType<T>::type>) {
+            if (flatNode.type == FlatNodeType::Sequence || flatNode.type == FlatNodeType::Map) {
+                for (auto entry = document->BeginEntries(flatNode); entry != document->EndEntries(flatNode); ++entry) {
+                    try {
+                        ToYaml(entry->node).template as<typename ElementType<T>::type>();
+                    } catch (const YAML::BadConversion&) {
+                        ThrowBadConversion<typename ElementType<T>::type>(entry->node);
+                    }
+                }
+            }
+        }
+        YAML::Mark mark;
+        mark.line = (int)flatNode.line;
+        mark.column = (int)flatNode.column;
+        throw YAML::TypedBadConversion<T>(mark);
+    }
+
+    /**
+     * Convert the value with yaml-cpp, reporting any failure at its position in the document
+     */
+    template <typename T>
+    T Convert(std::uint32_t valueNode) const {
+        try {
+            return ToYaml(valueNode).template as<T>();
+        } catch (const YAML::BadConversion&) {
+            ThrowBadConversion<T>(valueNode);
+        }
+    }
+
+    /***
+     * Helper Function to get the correct parameters
+     */
+    template <typename T>
+    inline std::optional<std::uint32_t> GetParameter(const ArgumentIdentifier<T>& identifier) const {
+        // treat this node as the item if the identifier is default
+        if (identifier.inputName.empty()) {
+            return node;
+        } else {
+            return FindChild(identifier.inputName);
+        }
+    }
+
+    template <typename T>
+    inline T GetValue(const ArgumentIdentifier<T>& identifier) const {
+        auto parameter = GetParameter(identifier);
+        if (!parameter) {
+            if (identifier.optional) {
+                return {};
+            } else {
+                throw std::invalid_argument("unable to locate " + identifier.inputName + " in " + nodePath);
+            }
+        }
+        MarkUsage(identifier.inputName);
+        if constexpr (NumericConverter::IsConvertible<T>::value) {
+            T value{};
+            if (TryConvert(*parameter, value)) {
+                return value;
+            }
+        }
+        return Convert<T>(*parameter);
+    }
+
+   public:
+    /**
+     * Map a binary config file written by the BinarySerializer or a yaml file
+     * @param filePath
+     * @param format
+     */
+    explicit MappedFactory(const std::filesystem::path& filePath, MappedFileFormat format = MappedFileFormat::Binary);
+
+    /**
+     * Create the root factory for the document
+     * @param document
+     * @param searchDirectories
+     */
+    explicit MappedFactory(std::shared_ptr<const FlatDocument> document, std::vector<std::filesystem::path> searchDirectories = {});
+
+    ~MappedFactory() override = default;
+
+    // allow derived access to all Get
+    using cppParser::Factory::Get;
+
+    /* gets the class type represented by this factory */
+    const std::string& GetClassType() const override { return type; }
+
+    /* return a string*/
+    std::string Get(const ArgumentIdentifier<std::string>& identifier) const override;
+
+    bool Get(const ArgumentIdentifier<bool>& identifier) const override { return GetValue<bool>(identifier); }
+
+    double Get(const ArgumentIdentifier<double>& identifier) const override { return GetValue<double>(identifier); }
+
+    int Get(const ArgumentIdentifier<int>& identifier) const override { return GetValue<int>(identifier); }
+
+    std::vector<int> Get(const ArgumentIdentifier<std::vector<int>>& identifier) const override { return GetValue<std::vector<int>>(identifier); }
+
+    std::vector<double> Get(const ArgumentIdentifier<std::vector<double>>& identifier) const override { return GetValue<std::vector<double>>(identifier); }
+
+    std::vector<std::string> Get(const ArgumentIdentifier<std::vector<std::string>>& identifier) const override { return GetValue<std::vector<std::string>>(identifier); }
+
+    std::vector<std::vector<int>> Get(const ArgumentIdentifier<std::vector<std::vector<int>>>& identifier) const override { return GetValue<std::vector<std::vector<int>>>(identifier); }
+
+    std::vector<std::vector<double>> Get(const ArgumentIdentifier<std::vector<std::vector<double>>>& identifier) const override {
+        return GetValue<std::vector<std::vector<double>>>(identifier);
+    }
+
+    std::vector<std::vector<std::string>> Get(const ArgumentIdentifier<std::vector<std::vector<std::string>>>& identifier) const override {
+        return GetValue<std::vector<std::vector<std::string>>>(identifier);
+    }
+
+    std::map<std::string, std::string> Get(const ArgumentIdentifier<std::map<std::string, std::string>>& identifier) const override {
+        return GetValue<std::map<std::string, std::string>>(identifier);
+    }
+
+    /* return a factory that serves as the root of the requested item */
+    std::shared_ptr<Factory> GetFactory(const std::string& name) const override;
+
+    /* get all children as factory */
+    std::vector<std::shared_ptr<Factory>> GetFactorySequence(const std::string& name) const override;
+
+    bool Contains(const std::string& name) const override;
+
+    std::unordered_set<std::string> GetKeys() const override;
+
+    /* the child factory of each entry in document order, duplicate keys resolve to the first entry */
+    std::vector<std::pair<std::string, std::shared_ptr<Factory>>> GetFactoryEntries() const override;
+
+    /** get unused values **/
+    std::vector<std::string> GetUnusedValues() const override;
+
+    /** factories are the same when they are the same node in the same document **/
+    bool SameFactory(const Factory& otherFactory) const override;
+
+    /** return a hash of the node **/
+    std::size_t GetHash() const override;
+
+    /**
+     * returns the path to a file as specified using a file locator instance.  This override allows searching in search directories
+     * @param identifier
+     * @return
+     */
+    std::filesystem::path Get(const ArgumentIdentifier<std::filesystem::path>& identifier) const override;
+};
+}  // namespace cppParser
+
+#endif  // CPPPARSER_MAPPEDFACTORY_HPP
@@ -0,0 +1,42 @@
+#include "mappedFile.hpp"
+#include <fstream>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+cppParser::MappedFile::MappedFile(const std::filesystem::path& path) {
+    size = std::filesystem::file_size(path);
+#if defined(__unix__) || defined(__APPLE__)
+    if (size > 0) {
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            throw std::invalid_argument("unable to open " + path.string());
+        }
+        mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw std::invalid_argument("unable to map " + path.string());
+        }
+        data = static_cast<const char*>(mapping);
+    }
+#else
+    buffer.resize(size);
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.read(buffer.data(), (std::streamsize)size)) {
+        throw std::invalid_argument("unable to read " + path.string());
+    }
+    data = buffer.data();
+#endif
+}
+
+cppParser::MappedFile::~MappedFile() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapping) {
+        munmap(mapping, size);
+    }
+#endif
+}
@@ -0,0 +1,36 @@
+#ifndef CPPPARSER_MAPPEDFILE_HPP
+#define CPPPARSER_MAPPEDFILE_HPP
+
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace cppParser {
+
+/**
+ * The read only bytes of a file.  The file is memory mapped when supported, otherwise it is read into memory.
+ */
+class MappedFile {
+   private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+#if defined(__unix__) || defined(__APPLE__)
+    void* mapping = nullptr;
+#else
+    std::vector<char> buffer;
+#endif
+
+   public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] inline const char* GetData() const { return data; }
+    [[nodiscard]] inline std::size_t GetSize() const { return size; }
+    [[nodiscard]] inline std::string_view GetView() const { return {data, size}; }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_MAPPEDFILE_HPP
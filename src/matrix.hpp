@@ -0,0 +1,81 @@
+#ifndef CPPPARSER_MATRIX_HPP
+#define CPPPARSER_MATRIX_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppParser {
+
+/**
+ * A rectangular table of values stored row-major in a single contiguous vector.  Used as an argument type in place of a vector of vectors when every row has the same length.
+ */
+template <typename T>
+class Matrix {
+   private:
+    std::size_t rows = 0;
+    std::size_t columns = 0;
+    std::vector<T> values;
+
+   public:
+    Matrix() = default;
+
+    /**
+     * Create the matrix from row-major values
+     * @param rows
+     * @param columns
+     * @param values
+     */
+    Matrix(std::size_t rows, std::size_t columns, std::vector<T> values) : rows(rows), columns(columns), values(std::move(values)) {
+        if (this->values.size() != rows * columns) {
+            throw std::invalid_argument("a " + std::to_string(rows) + "x" + std::to_string(columns) + " matrix cannot hold " + std::to_string(this->values.size()) + " values");
+        }
+    }
+
+    /**
+     * Copy the rows into the matrix, every row must be the same length
+     * @param rowValues
+     */
+    explicit Matrix(const std::vector<std::vector<T>>& rowValues) : rows(rowValues.size()), columns(rowValues.empty() ? 0 : rowValues.front().size()) {
+        values.reserve(rows * columns);
+        for (const auto& row : rowValues) {
+            if (row.size() != columns) {
+                throw std::invalid_argument("matrix rows must all be " + std::to_string(columns) + " long, found a row of " + std::to_string(row.size()));
+            }
+            values.insert(values.end(), row.begin(), row.end());
+        }
+    }
+
+    [[nodiscard]] inline std::size_t Rows() const { return rows; }
+
+    [[nodiscard]] inline std::size_t Columns() const { return columns; }
+
+    [[nodiscard]] inline std::size_t size() const { return values.size(); }
+
+    [[nodiscard]] inline bool empty() const { return values.empty(); }
+
+    /* the row-major values */
+    [[nodiscard]] inline const T* data() const { return values.data(); }
+
+    inline T* data() { return values.data(); }
+
+    inline const T& operator()(std::size_t row, std::size_t column) const { return values[row * columns + column]; }
+
+    inline T& operator()(std::size_t row, std::size_t column) { return values[row * columns + column]; }
+
+    /* the first value in the row */
+    inline const T* Row(std::size_t row) const { return values.data() + row * columns; }
+
+    inline auto begin() const { return values.begin(); }
+
+    inline auto end() const { return values.end(); }
+
+    bool operator==(const Matrix<T>& other) const { return rows == other.rows && columns == other.columns && values == other.values; }
+
+    bool operator!=(const Matrix<T>& other) const { return !(*this == other); }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_MATRIX_HPP
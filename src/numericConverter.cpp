@@ -0,0 +1,33 @@
+#include "numericConverter.hpp"
+#include <charconv>
+
+static inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool cppParser::NumericConverter::TryParse(std::string_view scalar, int& value) {
+    // the stream conversion detects the base, so a leading zero (octal/hex) is left to YAML::convert
+    auto digits = !scalar.empty() && scalar.front() == '-' ? scalar.substr(1) : scalar;
+    if (digits.empty() || !IsDigit(digits.front()) || (digits.front() == '0' && digits.size() > 1)) {
+        return false;
+    }
+
+    const auto end = scalar.data() + scalar.size();
+    auto [ptr, error] = std::from_chars(scalar.data(), end, value);
+    return error == std::errc() && ptr == end;
+}
+
+bool cppParser::NumericConverter::TryParse(std::string_view scalar, double& value) {
+#if defined(__cpp_lib_to_chars)
+    // from_chars also reads inf/nan and hex forms that the stream conversion rejects, so only digits or a point may start the number
+    auto digits = !scalar.empty() && scalar.front() == '-' ? scalar.substr(1) : scalar;
+    if (digits.empty() || !(IsDigit(digits.front()) || digits.front() == '.')) {
+        return false;
+    }
+
+    const auto end = scalar.data() + scalar.size();
+    auto [ptr, error] = std::from_chars(scalar.data(), end, value);
+    return error == std::errc() && ptr == end;
+#else
+    // floating point from_chars is not available in this standard library
+    return false;
+#endif
+}
@@ -0,0 +1,94 @@
+#ifndef CPPPARSER_NUMERICCONVERTER_HPP
+#define CPPPARSER_NUMERICCONVERTER_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace cppParser {
+
+/**
+ * Converts yaml scalars to numbers with std::from_chars instead of the std::stringstream used by YAML::convert.  Only the plain decimal forms are converted here, and the
+ * results are bit-identical to YAML::convert for them.  Anything else (hex/octal ints, leading '+', .inf/.nan, whitespace, out of range values, ...) is reported as not converted
+ * so that the caller can fall back to YAML::convert for the same value or error.
+ */
+class NumericConverter {
+   public:
+    NumericConverter() = delete;
+
+    /**
+     * True for the int/double types and (nested) vectors of them that can be converted here
+     */
+    template <typename T>
+    struct IsConvertible : std::bool_constant<std::is_same_v<T, int> || std::is_same_v<T, double>> {};
+
+    template <typename T>
+    struct IsConvertible<std::vector<T>> : IsConvertible<T> {};
+
+    /**
+     * Parse a base 10 int
+     * @param scalar
+     * @param value
+     * @return false if the scalar could not be parsed here
+     */
+    static bool TryParse(std::string_view scalar, int& value);
+
+    /**
+     * Parse a decimal double
+     * @param scalar
+     * @param value
+     * @return false if the scalar could not be parsed here
+     */
+    static bool TryParse(std::string_view scalar, double& value);
+
+    /**
+     * Convert a scalar node
+     * @param node
+     * @param value
+     * @return false if the node could not be converted here
+     */
+    template <typename T>
+    static std::enable_if_t<std::is_arithmetic_v<T>, bool> TryConvert(const YAML::Node& node, T& value) {
+        return node.IsScalar() && TryParse(node.Scalar(), value);
+    }
+
+    /**
+     * Convert a sequence node, the vector capacity is reserved before converting the elements
+     * @param node
+     * @param values
+     * @return false if any element could not be converted here
+     */
+    template <typename T>
+    static bool TryConvert(const YAML::Node& node, std::vector<T>& values) {
+        if (!node.IsSequence()) {
+            return false;
+        }
+
+        // count with the iterators, size() updates a cached size in the node
+        values.reserve(std::distance(node.begin(), node.end()));
+        for (const auto& element : node) {
+            if (!TryConvert(element, values.emplace_back())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Convert the node, falling back to YAML::convert when the fast path cannot be used
+     * @param node
+     * @return
+     */
+    template <typename T>
+    static T Convert(const YAML::Node& node) {
+        T value{};
+        if (TryConvert(node, value)) {
+            return value;
+        }
+        return node.template as<T>();
+    }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_NUMERICCONVERTER_HPP
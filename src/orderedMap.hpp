@@ -0,0 +1,86 @@
+#ifndef CPPPARSER_ORDEREDMAP_HPP
+#define CPPPARSER_ORDEREDMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace cppParser {
+
+/**
+ * A flat map that keeps the entries in insertion (document) order.  Used as an argument type in place of a std::map when the order of the input matters or when the map is only
+ * iterated.  The entries are stored in a single vector, so lookups are a linear search.
+ */
+template <typename Key, typename Value>
+class OrderedMap {
+   public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+   private:
+    std::vector<value_type> entries;
+
+   public:
+    OrderedMap() = default;
+
+    /**
+     * Take the entries in order, every key must be unique
+     * @param entries
+     */
+    explicit OrderedMap(std::vector<value_type> entries) : entries(std::move(entries)) {}
+
+    OrderedMap(std::initializer_list<value_type> entries) {
+        for (const auto& entry : entries) {
+            insert(entry);
+        }
+    }
+
+    [[nodiscard]] inline std::size_t size() const { return entries.size(); }
+
+    [[nodiscard]] inline bool empty() const { return entries.empty(); }
+
+    inline auto begin() const { return entries.begin(); }
+
+    inline auto end() const { return entries.end(); }
+
+    inline const_iterator find(const Key& key) const {
+        return std::find_if(entries.begin(), entries.end(), [&key](const auto& entry) { return entry.first == key; });
+    }
+
+    [[nodiscard]] inline std::size_t count(const Key& key) const { return find(key) != entries.end() ? 1 : 0; }
+
+    [[nodiscard]] inline bool contains(const Key& key) const { return find(key) != entries.end(); }
+
+    inline const Value& at(const Key& key) const {
+        auto entry = find(key);
+        if (entry == entries.end()) {
+            throw std::out_of_range("key is not in the ordered map");
+        }
+        return entry->second;
+    }
+
+    /**
+     * Append the entry when the key is not already in the map
+     * @return the entry with the key and if it was inserted
+     */
+    std::pair<const_iterator, bool> insert(value_type entry) {
+        if (auto existing = find(entry.first); existing != entries.end()) {
+            return {existing, false};
+        }
+        entries.push_back(std::move(entry));
+        return {std::prev(entries.cend()), true};
+    }
+
+    bool operator==(const OrderedMap<Key, Value>& other) const { return entries == other.entries; }
+
+    bool operator!=(const OrderedMap<Key, Value>& other) const { return !(*this == other); }
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_ORDEREDMAP_HPP
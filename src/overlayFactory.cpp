@@ -0,0 +1,302 @@
+#include "overlayFactory.hpp"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <set>
+#include "yamlParser.hpp"
+
+/**
+ * The path segment used in node paths, i.e. "[1]" is reported as "1" like the sequence children of the YamlParser
+ */
+static std::string PathSegment(const std::string& key) { return key.size() > 1 && key.front() == '[' && key.back() == ']' ? key.substr(1, key.size() - 2) : key; }
+
+/**
+ * The index of a "[index]" path segment
+ * @param segment
+ * @param path the overwritten path, used in the error
+ */
+static std::size_t SegmentIndex(const std::string& segment, const std::string& path) {
+    const auto index = PathSegment(segment);
+    // the yaml nodes are indexed by int, so larger indices are rejected rather than wrapped
+    if (segment.size() < 3 || segment.front() != '[' || segment.back() != ']' || index.size() > 10 || !std::all_of(index.begin(), index.end(), [](unsigned char c) { return std::isdigit(c); }) ||
+        std::stoull(index) > static_cast<unsigned long long>(std::numeric_limits<int>::max())) {
+        throw std::invalid_argument("unable to overwrite item " + path + ", " + segment + " is not a sequence index");
+    }
+    return std::stoul(index);
+}
+
+static std::vector<std::string> SplitPath(const std::string& key) {
+    std::vector<std::string> segments;
+    std::size_t begin = 0;
+    for (auto separator = key.find("::"); separator != std::string::npos; separator = key.find("::", begin)) {
+        segments.push_back(key.substr(begin, separator - begin));
+        begin = separator + 2;
+    }
+    segments.push_back(key.substr(begin));
+    return segments;
+}
+
+cppParser::OverlayFactory::OverlayFactory(std::shared_ptr<Factory> base, std::shared_ptr<const OverlayNode> overlay, std::string nodePath,
+                                          std::weak_ptr<InstanceTracker> instanceTracker)
+    : Factory(std::move(instanceTracker), base->executor), base(std::move(base)), overlay(std::move(overlay)), nodePath(std::move(nodePath)), values([this] {
+          if (this->overlay->values.empty()) {
+              return std::shared_ptr<Factory>();
+          }
+          YAML::Node valuesNode(YAML::NodeType::Map);
+          for (const auto& [key, value] : this->overlay->values) {
+              valuesNode[key] = value;
+          }
+          return std::static_pointer_cast<Factory>(std::make_shared<YamlParser>(valuesNode));
+      }()) {}
+
+cppParser::OverlayFactory::OverlayFactory(std::shared_ptr<Factory> base, const std::map<std::string, std::string>& overwriteParameters)
+    : OverlayFactory(std::move(base), BuildOverlay(overwriteParameters), "root", {}) {
+    rootInstanceTracker = std::make_shared<InstanceTracker>(InstanceTrackerOptions{}, this->base->GetInstanceTracker());
+    instanceTracker = rootInstanceTracker;
+}
+
+std::shared_ptr<const cppParser::OverlayFactory::OverlayNode> cppParser::OverlayFactory::BuildOverlay(const std::map<std::string, std::string>& overwriteParameters) {
+    auto root = std::make_shared<OverlayNode>();
+
+    for (const auto& [key, value] : overwriteParameters) {
+        auto segments = SplitPath(key);
+        auto node = root;
+        std::size_t depth = 0;
+        for (; depth < segments.size(); depth++) {
+            // record the overwrite relative to each node along the path
+            std::string relativePath;
+            for (auto i = depth; i < segments.size(); i++) {
+                relativePath += (i > depth ? "::" : "") + segments[i];
+            }
+            node->overwrites += relativePath + "=" + value + "\n";
+
+            if (depth + 1 == segments.size() || node->values.count(segments[depth])) {
+                break;
+            }
+            auto& child = node->children[segments[depth]];
+            if (!child) {
+                child = std::make_shared<OverlayNode>();
+            }
+            node = child;
+        }
+
+        const auto& segment = segments[depth];
+        if (depth + 1 == segments.size()) {
+            // the whole value is replaced, so any earlier overwrites below it are dropped
+            node->values[segment] = YAML::Load(value);
+            node->children.erase(segment);
+        } else {
+            // a value that was already replaced is updated in place
+            auto replaced = node->values[segment];
+            for (auto i = depth + 1; i + 1 < segments.size(); i++) {
+                replaced.reset(segments[i].front() == '[' ? replaced[static_cast<int>(SegmentIndex(segments[i], key))] : replaced[segments[i]]);
+            }
+            const auto& lastSegment = segments.back();
+            if (lastSegment.front() == '[') {
+                replaced[static_cast<int>(SegmentIndex(lastSegment, key))] = YAML::Load(value);
+            } else {
+                replaced[lastSegment] = YAML::Load(value);
+            }
+        }
+    }
+
+    return root;
+}
+
+std::shared_ptr<cppParser::OverlayFactory> cppParser::OverlayFactory::GetOverlayChild(const std::string& name, const std::shared_ptr<Factory>& baseChild) const {
+    std::lock_guard<std::mutex> lock(childFactoriesMutex);
+    auto& overlayChild = overlayChildren[name];
+    if (!overlayChild) {
+        overlayChild = std::shared_ptr<OverlayFactory>(new OverlayFactory(baseChild, overlay->children.at(name), nodePath + "/" + PathSegment(name), instanceTracker));
+    }
+    return overlayChild;
+}
+
+std::shared_ptr<cppParser::OverlayFactory> cppParser::OverlayFactory::GetSequenceOverlay(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(childFactoriesMutex);
+    auto& sequenceOverlay = sequenceOverlays[name];
+    if (!sequenceOverlay) {
+        sequenceOverlay = std::shared_ptr<OverlayFactory>(new OverlayFactory(base, overlay->children.at(name), nodePath + "/" + name, instanceTracker));
+    }
+    return sequenceOverlay;
+}
+
+std::shared_ptr<cppParser::Factory> cppParser::OverlayFactory::GetFactory(const std::string& name) const {
+    if (overlay->values.count(name)) {
+        return values->GetFactory(name);
+    }
+    MarkUsed(name);
+
+    if (!overlay->children.count(name)) {
+        // unchanged children are shared with the base, and kept to report their unused values
+        auto sharedChild = base->GetFactory(name);
+        std::lock_guard<std::mutex> lock(childFactoriesMutex);
+        return sharedChildren.emplace(name, sharedChild).first->second;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(childFactoriesMutex);
+        if (auto overlayChild = overlayChildren.find(name); overlayChild != overlayChildren.end()) {
+            return overlayChild->second;
+        }
+    }
+
+    // overwrites may add a map that is not in the base
+    auto baseChild = base->Contains(name) ? base->GetFactory(name) : std::make_shared<YamlParser>(YAML::Node(YAML::NodeType::Map));
+    return GetOverlayChild(name, baseChild);
+}
+
+std::vector<std::shared_ptr<cppParser::Factory>> cppParser::OverlayFactory::GetFactorySequence(const std::string& name) const {
+    if (overlay->values.count(name)) {
+        return values->GetFactorySequence(name);
+    }
+
+    MarkUsed(name);
+    auto children = base->GetFactorySequence(name);
+    if (overlay->children.count(name)) {
+        // replace the overwritten elements
+        auto sequenceOverlay = GetSequenceOverlay(name);
+        const auto& elementOverlay = *sequenceOverlay->overlay;
+        for (const auto& [key, value] : elementOverlay.values) {
+            auto index = SegmentIndex(key, nodePath + "/" + name + "/" + key);
+            if (index >= children.size()) {
+                throw std::invalid_argument("unable to overwrite item " + key + " in " + nodePath + "/" + name);
+            }
+            children[index] = sequenceOverlay->values->GetFactory(key);
+        }
+        for (const auto& [key, childOverlay] : elementOverlay.children) {
+            auto index = SegmentIndex(key, nodePath + "/" + name + "/" + key);
+            if (index >= children.size()) {
+                throw std::invalid_argument("unable to overwrite item " + key + " in " + nodePath + "/" + name);
+            }
+            children[index] = sequenceOverlay->GetOverlayChild(key, children[index]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(childFactoriesMutex);
+    sequenceChildren[name] = children;
+    return children;
+}
+
+bool cppParser::OverlayFactory::Contains(const std::string& name) const {
+    if (overlay->values.count(name)) {
+        return values->Contains(name);
+    }
+    return overlay->children.count(name) || base->Contains(name);
+}
+
+std::unordered_set<std::string> cppParser::OverlayFactory::GetKeys() const {
+    auto keys = base->GetKeys();
+    for (const auto& value : overlay->values) {
+        keys.insert(value.first);
+    }
+    for (const auto& child : overlay->children) {
+        keys.insert(child.first);
+    }
+    return keys;
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<cppParser::Factory>>> cppParser::OverlayFactory::GetFactoryEntries() const {
+    auto entries = base->GetFactoryEntries();
+    std::unordered_set<std::string> baseKeys;
+    for (auto& [key, child] : entries) {
+        baseKeys.insert(key);
+        if (overlay->values.count(key)) {
+            child = values->GetFactory(key);
+            continue;
+        }
+        MarkUsed(key);
+        if (overlay->children.count(key)) {
+            child = GetOverlayChild(key, child);
+        } else {
+            std::lock_guard<std::mutex> lock(childFactoriesMutex);
+            sharedChildren.emplace(key, child);
+        }
+    }
+
+    for (const auto& value : overlay->values) {
+        if (!baseKeys.count(value.first)) {
+            entries.emplace_back(value.first, GetFactory(value.first));
+        }
+    }
+    for (const auto& child : overlay->children) {
+        if (!baseKeys.count(child.first)) {
+            entries.emplace_back(child.first, GetFactory(child.first));
+        }
+    }
+    return entries;
+}
+
+void cppParser::OverlayFactory::MarkUsed(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(childFactoriesMutex);
+    usedKeys.insert(name);
+}
+
+void cppParser::OverlayFactory::AddUnusedOverwrites(std::vector<std::string>& unused) const {
+    if (values) {
+        // the values parser reports paths from its own root
+        for (const auto& value : values->GetUnusedValues()) {
+            unused.push_back(nodePath + value.substr(value.find('/')));
+        }
+    }
+}
+
+std::vector<std::string> cppParser::OverlayFactory::GetUnusedValues() const {
+    std::vector<std::string> unused;
+    AddUnusedOverwrites(unused);
+
+    // the keys not read through this variant, sorted like the YamlParser.  The children are reported by the factory handed out for them.
+    const auto keys = GetKeys();
+    std::lock_guard<std::mutex> lock(childFactoriesMutex);
+    for (const auto& key : std::set<std::string>(keys.begin(), keys.end())) {
+        if (overlay->values.count(key)) {
+            continue;
+        }
+        if (!allUsed && !usedKeys.count(key)) {
+            unused.push_back(nodePath + "/" + key);
+            continue;
+        }
+
+        std::vector<std::string> childUnused;
+        if (auto overlayChild = overlayChildren.find(key); overlayChild != overlayChildren.end()) {
+            childUnused = overlayChild->second->GetUnusedValues();
+        } else if (auto sharedChild = sharedChildren.find(key); sharedChild != sharedChildren.end()) {
+            childUnused = sharedChild->second->GetUnusedValues();
+        } else if (auto sequence = sequenceChildren.find(key); sequence != sequenceChildren.end()) {
+            auto sequenceOverlay = sequenceOverlays.find(key);
+            for (std::size_t i = 0; i < sequence->second.size(); i++) {
+                // replaced elements are reported by the values of the sequence overlay
+                if (sequenceOverlay == sequenceOverlays.end() || !sequenceOverlay->second->overlay->values.count("[" + std::to_string(i) + "]")) {
+                    auto elementUnused = sequence->second[i]->GetUnusedValues();
+                    childUnused.insert(childUnused.end(), elementUnused.begin(), elementUnused.end());
+                }
+            }
+            if (sequenceOverlay != sequenceOverlays.end()) {
+                sequenceOverlay->second->AddUnusedOverwrites(childUnused);
+            }
+        }
+        unused.insert(unused.end(), childUnused.begin(), childUnused.end());
+    }
+    return unused;
+}
+
+bool cppParser::OverlayFactory::SameFactory(const Factory& otherFactory) const {
+    const auto otherOverlay = dynamic_cast<const OverlayFactory*>(&otherFactory);
+    return otherOverlay && overlay->overwrites == otherOverlay->overlay->overwrites && base->SameFactory(*otherOverlay->base);
+}
+
+std::size_t cppParser::OverlayFactory::GetHash() const {
+    auto seed = base->GetHash();
+    seed ^= std::hash<std::string>{}(overlay->overwrites) + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+void cppParser::OverlayFactory::MarkAllUsed() const {
+    {
+        std::lock_guard<std::mutex> lock(childFactoriesMutex);
+        allUsed = true;
+    }
+    if (values) {
+        values->MarkAllUsed();
+    }
+}
@@ -0,0 +1,173 @@
+#ifndef CPPPARSER_OVERLAYFACTORY_HPP
+#define CPPPARSER_OVERLAYFACTORY_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "factory.hpp"
+
+namespace cppParser {
+
+/**
+ * A copy-on-write variant of a base factory.  Only the overwritten values are stored, every other value and child factory is read from the (shared, unchanged) base.  The
+ * overwriteParameters use the same "key::[index]::key" paths as the YamlParser and each value is parsed as yaml.
+ *
+ * Each variant has its own instance tracker chained to the tracker of the base.  Instances created from unchanged children are held by the base tracker and shared by every
+ * variant, instances created from overwritten children are held by the variant and released with it.  The unused values are tracked per variant, although values read
+ * through a variant are also marked used in the base.
+ */
+class OverlayFactory : public Factory {
+   private:
+    /**
+     * The overwritten values below one node, i.e. "key" or "[index]" for a sequence element.  The nodes are not changed after they are built.
+     */
+    struct OverlayNode {
+        std::map<std::string, YAML::Node> values;
+        std::map<std::string, std::shared_ptr<OverlayNode>> children;
+
+        // every overwrite below this node as "path=value" lines, used to compare and hash variants
+        std::string overwrites;
+    };
+
+    const std::shared_ptr<Factory> base;
+    const std::shared_ptr<const OverlayNode> overlay;
+    const std::string nodePath;
+
+    // a parser over the values overwritten at this node, nullptr when there are none
+    const std::shared_ptr<Factory> values;
+
+    // the root variant holds the tracker chained to the base tracker, the children only reference it
+    std::shared_ptr<InstanceTracker> rootInstanceTracker;
+
+    mutable std::mutex childFactoriesMutex;
+    mutable std::map<std::string, std::shared_ptr<OverlayFactory>> overlayChildren;
+
+    // the overwritten elements of each sequence, the base of these overlays is only used for the instance tracker
+    mutable std::map<std::string, std::shared_ptr<OverlayFactory>> sequenceOverlays;
+
+    // the keys read through this variant and the unchanged children and sequences handed out from the base, guarded by the childFactoriesMutex
+    mutable std::unordered_set<std::string> usedKeys;
+    mutable bool allUsed = false;
+    mutable std::map<std::string, std::shared_ptr<Factory>> sharedChildren;
+    mutable std::map<std::string, std::vector<std::shared_ptr<Factory>>> sequenceChildren;
+
+    OverlayFactory(std::shared_ptr<Factory> base, std::shared_ptr<const OverlayNode> overlay, std::string nodePath, std::weak_ptr<InstanceTracker> instanceTracker);
+
+    /**
+     * Build the overlay tree from the overwriteParameters
+     */
+    static std::shared_ptr<const OverlayNode> BuildOverlay(const std::map<std::string, std::string>& overwriteParameters);
+
+    /**
+     * The overlay factory for a child with overwrites below it
+     */
+    std::shared_ptr<OverlayFactory> GetOverlayChild(const std::string& name, const std::shared_ptr<Factory>& baseChild) const;
+
+    /**
+     * The overlay holding the overwritten elements of a sequence
+     */
+    std::shared_ptr<OverlayFactory> GetSequenceOverlay(const std::string& name) const;
+
+    /**
+     * Record that the key was read through this variant
+     */
+    void MarkUsed(const std::string& name) const;
+
+    /**
+     * Add the unused overwritten values of this node
+     */
+    void AddUnusedOverwrites(std::vector<std::string>& unused) const;
+
+    /**
+     * Read an overwritten value from the values parser or fall through to the base
+     */
+    template <typename T>
+    inline T GetValue(const ArgumentIdentifier<T>& identifier) const {
+        if (overlay->values.count(identifier.inputName)) {
+            return values->Get(identifier);
+        }
+        MarkUsed(identifier.inputName);
+        return base->Get(identifier);
+    }
+
+   protected:
+    void MarkAllUsed() const override;
+
+   public:
+    /**
+     * Create a variant of the base factory
+     * @param base
+     * @param overwriteParameters
+     */
+    OverlayFactory(std::shared_ptr<Factory> base, const std::map<std::string, std::string>& overwriteParameters);
+
+    ~OverlayFactory() override = default;
+
+    // allow derived access to all Get
+    using cppParser::Factory::Get;
+
+    /* gets the class type represented by this factory */
+    const std::string& GetClassType() const override { return base->GetClassType(); }
+
+    std::string Get(const ArgumentIdentifier<std::string>& identifier) const override { return GetValue(identifier); }
+
+    int Get(const ArgumentIdentifier<int>& identifier) const override { return GetValue(identifier); }
+
+    bool Get(const ArgumentIdentifier<bool>& identifier) const override { return GetValue(identifier); }
+
+    double Get(const ArgumentIdentifier<double>& identifier) const override { return GetValue(identifier); }
+
+    std::vector<std::string> Get(const ArgumentIdentifier<std::vector<std::string>>& identifier) const override { return GetValue(identifier); }
+
+    std::vector<int> Get(const ArgumentIdentifier<std::vector<int>>& identifier) const override { return GetValue(identifier); }
+
+    std::vector<double> Get(const ArgumentIdentifier<std::vector<double>>& identifier) const override { return GetValue(identifier); }
+
+    std::vector<std::vector<int>> Get(const ArgumentIdentifier<std::vector<std::vector<int>>>& identifier) const override { return GetValue(identifier); }
+
+    std::vector<std::vector<double>> Get(const ArgumentIdentifier<std::vector<std::vector<double>>>& identifier) const override { return GetValue(identifier); }
+
+    std::vector<std::vector<std::string>> Get(const ArgumentIdentifier<std::vector<std::vector<std::string>>>& identifier) const override { return GetValue(identifier); }
+
+    std::map<std::string, std::string> Get(const ArgumentIdentifier<std::map<std::string, std::string>>& identifier) const override { return GetValue(identifier); }
+
+    Matrix<int> Get(const ArgumentIdentifier<Matrix<int>>& identifier) const override { return GetValue(identifier); }
+
+    Matrix<double> Get(const ArgumentIdentifier<Matrix<double>>& identifier) const override { return GetValue(identifier); }
+
+    Matrix<std::string> Get(const ArgumentIdentifier<Matrix<std::string>>& identifier) const override { return GetValue(identifier); }
+
+    ArrayView<int> Get(const ArgumentIdentifier<ArrayView<int>>& identifier) const override { return GetValue(identifier); }
+
+    ArrayView<double> Get(const ArgumentIdentifier<ArrayView<double>>& identifier) const override { return GetValue(identifier); }
+
+    std::filesystem::path Get(const ArgumentIdentifier<std::filesystem::path>& identifier) const override { return GetValue(identifier); }
+
+    /* return a factory that serves as the root of the requested item */
+    std::shared_ptr<Factory> GetFactory(const std::string& name) const override;
+
+    /* get all children as factory */
+    std::vector<std::shared_ptr<Factory>> GetFactorySequence(const std::string& name) const override;
+
+    bool Contains(const std::string& name) const override;
+
+    std::unordered_set<std::string> GetKeys() const override;
+
+    /* the entries of the base in its order with the overwritten children replaced, followed by the children only added by the overwrites */
+    std::vector<std::pair<std::string, std::shared_ptr<Factory>>> GetFactoryEntries() const override;
+
+    /** get the values not read through this variant, overwritten values in the base are not reported **/
+    std::vector<std::string> GetUnusedValues() const override;
+
+    /** variants are the same when the bases are the same and the overwrites are equal **/
+    bool SameFactory(const Factory& otherFactory) const override;
+
+    std::size_t GetHash() const override;
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_OVERLAYFACTORY_HPP
@@ -0,0 +1,78 @@
+#include "overwritePaths.hpp"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+cppParser::OverwritePaths::OverwritePaths(const std::map<std::string, std::string>& overwriteParameters) {
+    for (const auto& [key, value] : overwriteParameters) {
+        auto* pathNode = &root;
+        std::size_t begin = 0;
+        while (true) {
+            auto separator = key.find("::", begin);
+            std::string_view segment = std::string_view(key).substr(begin, separator == std::string::npos ? std::string::npos : separator - begin);
+
+            // only the segments before the last can index a sequence
+            int index = -1;
+            if (separator != std::string::npos && !segment.empty() && segment.front() == '[' && segment.back() == ']') {
+                index = std::stoi(std::string(segment.substr(1, segment.size() - 2)));
+            }
+
+            // the children keep the key order so that overlapping overwrites are applied in the same order as before
+            auto childKey = index < 0 ? std::string(segment) : std::string();
+            auto [position, inserted] = pathNode->childPositions.try_emplace({index, childKey}, pathNode->children.size());
+            if (inserted) {
+                pathNode->children.push_back(PathNode{.key = std::move(childKey), .index = index});
+            }
+            pathNode = &pathNode->children[position->second];
+
+            if (separator == std::string::npos) {
+                pathNode->value = value;
+                break;
+            }
+            begin = separator + 2;
+        }
+    }
+}
+
+/**
+ * True when yaml-cpp would load the value as a plain (untagged, non null) scalar with the same text
+ */
+static bool IsPlainScalar(std::string_view value) {
+    if (value.empty() || value == "null" || value == "Null" || value == "NULL") {
+        return false;
+    }
+
+    // a sign must start a number so that "-" or "--- " are not read as a sequence or document marker
+    auto first = value.front();
+    if (first == '-' || first == '+') {
+        if (value.size() == 1 || !(std::isdigit(static_cast<unsigned char>(value[1])) || value[1] == '.')) {
+            return false;
+        }
+    } else if (!std::isalnum(static_cast<unsigned char>(first)) && first != '.') {
+        return false;
+    }
+
+    return std::all_of(value.begin(), value.end(), [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_' || c == '-' || c == '+' || c == '/'; });
+}
+
+YAML::Node cppParser::OverwritePaths::ParseValue(const std::string& value) {
+    if (IsPlainScalar(value)) {
+        // match the non specific tag that yaml-cpp gives plain scalars
+        YAML::Node node(value);
+        node.SetTag("?");
+        return node;
+    }
+    return YAML::Load(value);
+}
+
+void cppParser::OverwritePaths::Apply(YAML::Node& node, const PathNode& pathNode) {
+    for (const auto& child : pathNode.children) {
+        auto childNode = child.index < 0 ? node[child.key] : node[child.index];
+        if (child.value) {
+            childNode = ParseValue(*child.value);
+        }
+        Apply(childNode, child);
+    }
+}
+
+void cppParser::OverwritePaths::Apply(YAML::Node& document) const { Apply(document, root); }
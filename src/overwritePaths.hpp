@@ -0,0 +1,54 @@
+#ifndef CPPPARSER_OVERWRITEPATHS_HPP
+#define CPPPARSER_OVERWRITEPATHS_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cppParser {
+
+/**
+ * The overwriteParameters ("key::[index]::key" to a yaml value) parsed once into a path trie.  The trie is applied to a document in a single traversal with the same result as
+ * replacing each value in key order.  Values that are plain scalars are converted directly instead of being loaded as yaml.
+ */
+class OverwritePaths {
+   private:
+    struct PathNode {
+        std::string key;
+        // the sequence index when the segment is "[index]", otherwise -1
+        int index = -1;
+        // the value set at this path before the children are applied
+        std::optional<std::string> value;
+        std::vector<PathNode> children;
+        // the position of each (index, key) in the children
+        std::map<std::pair<int, std::string>, std::size_t> childPositions;
+    };
+
+    PathNode root;
+
+    static void Apply(YAML::Node& node, const PathNode& pathNode);
+
+   public:
+    explicit OverwritePaths(const std::map<std::string, std::string>& overwriteParameters);
+
+    /**
+     * Apply every overwrite to the document
+     * @param document
+     */
+    void Apply(YAML::Node& document) const;
+
+    [[nodiscard]] inline bool Empty() const { return root.children.empty(); }
+
+    /**
+     * Parse the value as yaml, plain scalars are converted without the yaml parser
+     * @param value
+     * @return
+     */
+    static YAML::Node ParseValue(const std::string& value);
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_OVERWRITEPATHS_HPP
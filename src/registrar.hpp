@@ -1,7 +1,9 @@
 #ifndef CPPPARSER_REGISTRAR_HPP
 #define CPPPARSER_REGISTRAR_HPP
 
+#include <tuple>
 #include "factory.hpp"
+#include "instancePlan.hpp"
 
 /**
  * Register a class that takes a predefined set of arguments
@@ -110,6 +112,74 @@ template <typename Interface>
  * @tparam Interface
  */
 class Registrar {
+   private:
+    /**
+     * Get the argument from the factory.  Optional arguments are found with a single lookup and are default constructed when missing, like the optional Get.
+     */
+    template <typename T>
+    static inline auto GetArgument(const Factory& factory, const ArgumentIdentifier<T>& identifier) {
+        if (identifier.optional) {
+            return factory.TryGet(identifier).value_or(decltype(factory.Get(identifier)){});
+        }
+        return factory.Get(identifier);
+    }
+
+    /**
+     * A missing optional enum is read from an empty string, like the optional Get
+     */
+    template <typename ENUM>
+    static inline ENUM GetArgument(const Factory& factory, const ArgumentIdentifier<EnumWrapper<ENUM>>& identifier) {
+        if (identifier.optional) {
+            if (auto value = factory.TryGet(identifier)) {
+                return *value;
+            }
+            return EnumWrapper<ENUM>(std::string());
+        }
+        return factory.Get(identifier);
+    }
+
+    /**
+     * The details of a registration that are only needed for the listing, released once the listing entry is built.  The names are passed as std::string so they are copied
+     * once, the argument identifiers are shared with the create and plan methods.
+     */
+    template <typename... Args>
+    struct ListingRecord {
+        const std::string className;
+        const std::string description;
+        const bool defaultConstructor;
+        const std::shared_ptr<const std::tuple<ArgumentIdentifier<Args>...>> arguments;
+    };
+
+    /**
+     * Build the class entry from the record when the listing is read
+     */
+    template <typename... Args>
+    static Listing::ClassEntry BuildClassEntry(const void* listingRecord) {
+        const auto& record = *static_cast<const ListingRecord<Args...>*>(listingRecord);
+        std::vector<Listing::ArgumentEntry> arguments;
+        if constexpr (sizeof...(Args) > 0) {
+            arguments = std::apply([](const auto&... args) { return std::vector<Listing::ArgumentEntry>{BuildArgumentEntry(args)...}; }, *record.arguments);
+        }
+        return Listing::ClassEntry{.interface = std::string(Demangler::Demangle<Interface>()),
+                                   .className = record.className,
+                                   .description = record.description,
+                                   .arguments = std::move(arguments),
+                                   .defaultConstructor = record.defaultConstructor};
+    }
+
+    /**
+     * Build the derived entry from the record when the listing is read
+     */
+    static Listing::DerivedEntry BuildDerivedEntry(const void* listingRecord) {
+        const auto& record = *static_cast<const ListingRecord<>*>(listingRecord);
+        return Listing::DerivedEntry{.interface = std::string(Demangler::Demangle<Interface>()), .className = record.className, .defaultConstructor = record.defaultConstructor};
+    }
+
+    template <typename T>
+    static inline Listing::ArgumentEntry BuildArgumentEntry(const ArgumentIdentifier<T>& identifier) {
+        return Listing::ArgumentEntry{.name = identifier.inputName, .interface = std::string(Demangler::Demangle<T>()), .description = identifier.description, .optional = identifier.optional};
+    }
+
    public:
     Registrar() = delete;
 
@@ -119,8 +189,8 @@ class Registrar {
         std::map<std::string, typename cppParser::Creator<Interface>::TCreateMethod>& methods = cppParser::Creator<Interface>::GetConstructionMethods();
         if (auto it = methods.find(className); it == methods.end()) {
             // Record the entry
-            Listing::Get().RecordListing(
-                Listing::ClassEntry{.interface = Demangler::Demangle<Interface>(), .className = className, .description = description, .arguments = {}, .defaultConstructor = defaultConstructor});
+            Listing::RecordDeferredListing(&BuildClassEntry<>,
+                                           std::shared_ptr<const void>(new ListingRecord<>{.className = className, .description = description, .defaultConstructor = defaultConstructor}));
 
             // create method
             methods[className] = method;
@@ -129,9 +199,13 @@ class Registrar {
                 if (cppParser::Creator<Interface>::GetDefaultClassName().empty()) {
                     cppParser::Creator<Interface>::GetDefaultClassName() = className;
                 } else {
-                    throw std::invalid_argument("the default parameter for " + Demangler::Demangle<Interface>() + " is already set as " + cppParser::Creator<Interface>::GetDefaultClassName());
+                    throw std::invalid_argument("the default parameter for " + std::string(Demangler::Demangle<Interface>()) + " is already set as " +
+                                                cppParser::Creator<Interface>::GetDefaultClassName());
                 }
             }
+
+            // invalidate any cached create methods once the registration is complete
+            cppParser::Creator<Interface>::InvalidateCreateMethods();
         }
         return false;
     }
@@ -142,8 +216,8 @@ class Registrar {
         std::map<std::string, typename cppParser::Creator<Interface>::TCreateMethod>& methods = cppParser::Creator<Interface>::GetConstructionMethods();
         if (auto it = methods.find(className); it == methods.end()) {
             // Record the entry
-            Listing::Get().RecordListing(
-                Listing::ClassEntry{.interface = Demangler::Demangle<Interface>(), .className = className, .description = description, .arguments = {}, .defaultConstructor = defaultConstructor});
+            Listing::RecordDeferredListing(&BuildClassEntry<>,
+                                           std::shared_ptr<const void>(new ListingRecord<>{.className = className, .description = description, .defaultConstructor = defaultConstructor}));
 
             // create method
             methods[className] = [](std::shared_ptr<Factory> factory) { return std::make_shared<Class>(factory); };
@@ -152,9 +226,13 @@ class Registrar {
                 if (cppParser::Creator<Interface>::GetDefaultClassName().empty()) {
                     cppParser::Creator<Interface>::GetDefaultClassName() = className;
                 } else {
-                    throw std::invalid_argument("the default parameter for " + Demangler::Demangle<Interface>() + " is already set as " + cppParser::Creator<Interface>::GetDefaultClassName());
+                    throw std::invalid_argument("the default parameter for " + std::string(Demangler::Demangle<Interface>()) + " is already set as " +
+                                                cppParser::Creator<Interface>::GetDefaultClassName());
                 }
             }
+
+            // invalidate any cached create methods once the registration is complete
+            cppParser::Creator<Interface>::InvalidateCreateMethods();
         }
         return false;
     }
@@ -165,8 +243,8 @@ class Registrar {
         std::map<std::string, typename cppParser::Creator<Interface>::TCreateMethod>& methods = cppParser::Creator<Interface>::GetConstructionMethods();
         if (auto it = methods.find(className); it == methods.end()) {
             // Record the entry
-            Listing::Get().RecordListing(
-                Listing::ClassEntry{.interface = Demangler::Demangle<Interface>(), .className = className, .description = description, .arguments = {}, .defaultConstructor = defaultConstructor});
+            Listing::RecordDeferredListing(&BuildClassEntry<>,
+                                           std::shared_ptr<const void>(new ListingRecord<>{.className = className, .description = description, .defaultConstructor = defaultConstructor}));
 
             // create method
             methods[className] = [](const std::shared_ptr<Factory>& factory) { return std::make_shared<Class>(); };
@@ -175,9 +253,13 @@ class Registrar {
                 if (cppParser::Creator<Interface>::GetDefaultClassName().empty()) {
                     cppParser::Creator<Interface>::GetDefaultClassName() = className;
                 } else {
-                    throw std::invalid_argument("the default parameter for " + Demangler::Demangle<Interface>() + " is already set as " + cppParser::Creator<Interface>::GetDefaultClassName());
+                    throw std::invalid_argument("the default parameter for " + std::string(Demangler::Demangle<Interface>()) + " is already set as " +
+                                                cppParser::Creator<Interface>::GetDefaultClassName());
                 }
             }
+
+            // invalidate any cached create methods once the registration is complete
+            cppParser::Creator<Interface>::InvalidateCreateMethods();
         }
         return false;
     }
@@ -187,25 +269,36 @@ class Registrar {
     static bool Register(bool defaultConstructor, const std::string&& className, const std::string&& description, ArgumentIdentifier<Args>&&... args) {
         std::map<std::string, typename cppParser::Creator<Interface>::TCreateMethod>& methods = cppParser::Creator<Interface>::GetConstructionMethods();
         if (auto it = methods.find(className); it == methods.end()) {
+            // the argument identifiers are shared by the listing, create, and plan methods
+            auto arguments = std::make_shared<const std::tuple<ArgumentIdentifier<Args>...>>(std::move(args)...);
+
             // Record the entry
-            Listing::Get().RecordListing(Listing::ClassEntry{
-                .interface = Demangler::Demangle<Interface>(),
-                .className = className,
-                .description = description,
-                .arguments = std::vector({Listing::ArgumentEntry{.name = args.inputName, .interface = Demangler::Demangle<Args>(), .description = args.description, .optional = args.optional}...}),
-                .defaultConstructor = defaultConstructor});
+            Listing::RecordDeferredListing(
+                &BuildClassEntry<Args...>,
+                std::shared_ptr<const void>(new ListingRecord<Args...>{.className = className, .description = description, .defaultConstructor = defaultConstructor, .arguments = arguments}));
 
             // create method
-            methods[className] = [=](const std::shared_ptr<Factory>& factory) { return std::make_shared<Class>(factory->Get(args)...); };
+            methods[className] = [arguments](const std::shared_ptr<Factory>& factory) {
+                return std::apply([&factory](const auto&... args) { return std::make_shared<Class>(GetArgument(*factory, args)...); }, *arguments);
+            };
+
+            // plan method to find the instances needed to create this class
+            cppParser::Creator<Interface>::GetPlanMethods()[className] = [arguments](const std::shared_ptr<Factory>& factory, InstancePlan& plan, std::size_t node) {
+                std::apply([&](const auto&... args) { (plan.AddArgument(factory, node, args), ...); }, *arguments);
+            };
 
             if (defaultConstructor) {
                 if (cppParser::Creator<Interface>::GetDefaultClassName().empty()) {
                     cppParser::Creator<Interface>::GetDefaultClassName() = className;
                 } else {
-                    throw std::invalid_argument("the default parameter for " + Demangler::Demangle<Interface>() + " is already set as " + cppParser::Creator<Interface>::GetDefaultClassName());
+                    throw std::invalid_argument("the default parameter for " + std::string(Demangler::Demangle<Interface>()) + " is already set as " +
+                                                cppParser::Creator<Interface>::GetDefaultClassName());
                 }
             }
 
+            // invalidate any cached create methods once the registration is complete
+            cppParser::Creator<Interface>::InvalidateCreateMethods();
+
             return true;
         }
         return false;
@@ -217,19 +310,27 @@ class Registrar {
         auto& methods = cppParser::Creator<Interface>::GetDerivedConstructionMethods();
         if (auto it = methods.find(derivedClassName); it == methods.end()) {
             // Record the entry
-            Listing::Get().RecordListing(Listing::DerivedEntry{.interface = Demangler::Demangle<Interface>(), .className = derivedClassName, .defaultConstructor = defaultConstructor});
+            Listing::RecordDeferredListing(&BuildDerivedEntry,
+                                           std::shared_ptr<const void>(new ListingRecord<>{.className = derivedClassName, .description = {}, .defaultConstructor = defaultConstructor}));
 
             // create method
             methods[derivedClassName] = [=](const std::string& className) { return cppParser::Creator<DerivedClass>::GetCreateMethod(className); };
+            cppParser::Creator<Interface>::GetDerivedPlanMethods()[derivedClassName] = [=](const std::string& className) {
+                return cppParser::Creator<DerivedClass>::GetPlanMethod(className);
+            };
 
             if (defaultConstructor) {
                 if (cppParser::Creator<Interface>::GetDefaultClassName().empty()) {
                     cppParser::Creator<Interface>::GetDefaultClassName() = cppParser::DerivedSymbol + derivedClassName;
                 } else {
-                    throw std::invalid_argument("the default parameter for " + Demangler::Demangle<Interface>() + " is already set as " + cppParser::Creator<Interface>::GetDefaultClassName());
+                    throw std::invalid_argument("the default parameter for " + std::string(Demangler::Demangle<Interface>()) + " is already set as " +
+                                                cppParser::Creator<Interface>::GetDefaultClassName());
                 }
             }
 
+            // invalidate any cached create methods once the registration is complete
+            cppParser::Creator<Interface>::InvalidateCreateMethods();
+
             return true;
         }
         return false;
@@ -0,0 +1,179 @@
+#include "workStealingExecutor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+struct cppParser::WorkStealingExecutor::TaskGroup {
+    std::atomic<std::size_t> remaining;
+    std::mutex mutex;
+    std::condition_variable complete;
+    std::exception_ptr exception;
+
+    // the group of the task that made the Run call, it waits for this group so it outlives it
+    const TaskGroup* const parent;
+
+    TaskGroup(std::size_t size, const TaskGroup* parent) : remaining(size), parent(parent) {}
+
+    /**
+     * True when this group is the group or nested below it
+     */
+    bool IsWithin(const TaskGroup* group) const {
+        for (auto current = this; current; current = current->parent) {
+            if (current == group) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * The queue owned by the current thread, set for worker threads only
+ */
+static thread_local const void* currentExecutor = nullptr;
+static thread_local std::size_t currentQueueIndex = 0;
+
+/**
+ * The group of the task running on the current thread, nullptr outside of a task
+ */
+static thread_local const void* currentGroup = nullptr;
+
+cppParser::WorkStealingExecutor::WorkStealingExecutor(std::size_t numberOfThreads) {
+    numberOfThreads = std::max<std::size_t>(numberOfThreads, 1);
+    for (std::size_t i = 0; i < numberOfThreads; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (std::size_t i = 0; i < numberOfThreads; i++) {
+        workers.emplace_back(&WorkStealingExecutor::WorkerLoop, this, i);
+    }
+}
+
+cppParser::WorkStealingExecutor::~WorkStealingExecutor() {
+    {
+        std::lock_guard lock(idleMutex);
+        stopping = true;
+    }
+    idleCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+bool cppParser::WorkStealingExecutor::TryTakeTask(std::size_t queueIndex, Task& task, const TaskGroup* within) {
+    auto isTakeable = [within](const Task& queued) { return !within || queued.group->IsWithin(within); };
+
+    // check the owned queue first, newest first
+    {
+        auto& queue = *queues[queueIndex];
+        std::lock_guard lock(queue.mutex);
+        auto queued = std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), isTakeable);
+        if (queued != queue.tasks.rend()) {
+            task = std::move(*queued);
+            queue.tasks.erase(std::next(queued).base());
+            queuedTasks--;
+            return true;
+        }
+    }
+
+    // steal the oldest task from any other queue
+    for (std::size_t offset = 1; offset < queues.size(); offset++) {
+        auto& queue = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        auto queued = std::find_if(queue.tasks.begin(), queue.tasks.end(), isTakeable);
+        if (queued != queue.tasks.end()) {
+            task = std::move(*queued);
+            queue.tasks.erase(queued);
+            queuedTasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void cppParser::WorkStealingExecutor::RunTask(Task& task) {
+    // restore the group of the interrupted task once this task is done, so nested Run calls know the group they belong to
+    const auto interruptedGroup = currentGroup;
+    currentGroup = task.group.get();
+    try {
+        task.function();
+    } catch (...) {
+        std::lock_guard lock(task.group->mutex);
+        if (!task.group->exception) {
+            task.group->exception = std::current_exception();
+        }
+    }
+    currentGroup = interruptedGroup;
+
+    // the last task to finish wakes the thread waiting in Run
+    if (task.group->remaining.fetch_sub(1) == 1) {
+        std::lock_guard lock(task.group->mutex);
+        task.group->complete.notify_all();
+    }
+}
+
+void cppParser::WorkStealingExecutor::WorkerLoop(std::size_t queueIndex) {
+    currentExecutor = this;
+    currentQueueIndex = queueIndex;
+
+    while (true) {
+        Task task;
+        if (TryTakeTask(queueIndex, task)) {
+            RunTask(task);
+            continue;
+        }
+
+        std::unique_lock lock(idleMutex);
+        idleCondition.wait(lock, [this] { return stopping || queuedTasks > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void cppParser::WorkStealingExecutor::Run(std::vector<std::function<void()>> tasks) {
+    // there is nothing to gain from queuing a single task
+    if (tasks.size() < 2) {
+        for (auto& task : tasks) {
+            task();
+        }
+        return;
+    }
+
+    // workers push to their own queue so the tasks stay local, other threads spread the tasks over every queue
+    const bool isWorker = currentExecutor == this;
+    const auto homeQueue = isWorker ? currentQueueIndex : nextQueue++ % queues.size();
+
+    auto group = std::make_shared<TaskGroup>(tasks.size(), static_cast<const TaskGroup*>(currentGroup));
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        auto& queue = *queues[isWorker ? homeQueue : (homeQueue + i) % queues.size()];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(Task{.function = std::move(tasks[i]), .group = group});
+        queuedTasks++;
+    }
+    {
+        // take the idle lock so a worker cannot miss the notification between checking and waiting
+        std::lock_guard lock(idleMutex);
+    }
+    idleCondition.notify_all();
+
+    // help run the tasks of this group (and the groups nested below it) until this group is complete
+    while (group->remaining > 0) {
+        Task task;
+        if (TryTakeTask(homeQueue, task, group.get())) {
+            RunTask(task);
+        } else {
+            // the remaining tasks are running on other threads, wake up periodically in case new nested tasks are queued
+            std::unique_lock lock(group->mutex);
+            group->complete.wait_for(lock, std::chrono::milliseconds(1), [&group] { return group->remaining == 0; });
+        }
+    }
+
+    if (group->exception) {
+        std::rethrow_exception(group->exception);
+    }
+}
+
+std::shared_ptr<cppParser::WorkStealingExecutor> cppParser::WorkStealingExecutor::Default() {
+    static auto executor = std::make_shared<WorkStealingExecutor>();
+    return executor;
+}
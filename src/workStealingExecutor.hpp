@@ -0,0 +1,97 @@
+#ifndef CPPPARSER_WORKSTEALINGEXECUTOR_HPP
+#define CPPPARSER_WORKSTEALINGEXECUTOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "executor.hpp"
+
+namespace cppParser {
+
+/**
+ * The default executor.  Each worker thread owns a queue of tasks and steals from the other queues when its own queue is empty.  Threads waiting on a Run call (including
+ * workers that start nested Run calls) execute queued tasks while they wait so nested parallel construction cannot starve the pool.  A waiting thread only runs the tasks
+ * of its own Run call and the calls nested below them, so an unrelated task never runs on top of (and never waits on) an instance the thread is still creating.
+ */
+class WorkStealingExecutor : public Executor {
+   private:
+    /**
+     * A group of tasks submitted by a single Run call
+     */
+    struct TaskGroup;
+
+    /**
+     * A single queued task and the group it reports to
+     */
+    struct Task {
+        std::function<void()> function;
+        std::shared_ptr<TaskGroup> group;
+    };
+
+    /**
+     * The queue owned by each worker.  The owner takes from the back while other threads steal from the front.
+     */
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    // the number of queued tasks and the mutex/condition used to wake idle workers
+    std::atomic<std::size_t> queuedTasks = 0;
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+    bool stopping = false;
+
+    // used to spread tasks submitted from outside the pool over the queues
+    std::atomic<std::size_t> nextQueue = 0;
+
+    /**
+     * Take a task from the specified queue first and then try to steal from the other queues
+     * @param queueIndex
+     * @param task
+     * @param within only take tasks of this group or the groups nested below it, any task when nullptr
+     */
+    bool TryTakeTask(std::size_t queueIndex, Task& task, const TaskGroup* within = nullptr);
+
+    /**
+     * Run the task and report the result to its group
+     */
+    static void RunTask(Task& task);
+
+    /**
+     * The loop run by each worker thread
+     */
+    void WorkerLoop(std::size_t queueIndex);
+
+   public:
+    /**
+     * Create the executor with the specified number of worker threads.  The default uses one worker per hardware thread.
+     * @param numberOfThreads
+     */
+    explicit WorkStealingExecutor(std::size_t numberOfThreads = std::thread::hardware_concurrency());
+    ~WorkStealingExecutor() override;
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /**
+     * Run the tasks on the worker threads, the calling thread also runs tasks until all are complete
+     * @param tasks
+     */
+    void Run(std::vector<std::function<void()>> tasks) override;
+
+    /**
+     * A shared executor that can be used when no executor is specified
+     * @return
+     */
+    static std::shared_ptr<WorkStealingExecutor> Default();
+};
+
+}  // namespace cppParser
+#endif  // CPPPARSER_WORKSTEALINGEXECUTOR_HPP
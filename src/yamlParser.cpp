@@ -1,124 +1,372 @@
 #include "yamlParser.hpp"
+#include <algorithm>
+#include <cctype>
+#include <set>
 #include <utility>
+#include "binarySerializer.hpp"
+#include "localPath.hpp"
+#include "mappedFile.hpp"
+#include "overwritePaths.hpp"
+
+cppParser::YamlParser::YamlParser(const YAML::Node& yamlConfiguration, std::shared_ptr<const NodeLocation> location, std::string type, std::vector<std::filesystem::path> searchDirectories,
+                                  const YamlParserOptions& options, std::weak_ptr<InstanceTracker> instanceTracker, std::shared_ptr<ArrayFiles> arrayFiles,
+                                  std::shared_ptr<const LazyYamlNode> lazyNode, std::shared_ptr<SharedDocument> document)
+    : Factory(std::move(instanceTracker), options.parallel ? (options.executor ? options.executor : WorkStealingExecutor::Default()) : nullptr),
+      type(std::move(type)),
+      location(std::move(location)),
+      yamlConfiguration(yamlConfiguration),
+      options(options),
+      searchDirectories(std::move(searchDirectories)),
+      childFactoriesMutex(options.threadSafe || options.parallel ? std::make_unique<std::shared_mutex>() : nullptr),
+      lazyNode(std::move(lazyNode)),
+      arrayFiles(arrayFiles ? std::move(arrayFiles) : std::make_shared<ArrayFiles>()),
+      document(document ? std::move(document) : std::make_shared<SharedDocument>()) {}
+
+cppParser::YamlParser::YamlParser(LoadedYaml loadedYaml, std::vector<std::filesystem::path> searchDirectories, const std::map<std::string, std::string>& overwriteParameters,
+                                  const YamlParserOptions& options)
+    : YamlParser(loadedYaml.node, std::make_shared<const NodeLocation>(NodeLocation{.parent = {}, .key = "root"}), "", std::move(searchDirectories), options, {}, {},
+                 loadedYaml.lazyNode) {
+    // create the root instance of the tracker
+    rootInstanceTracker = std::make_shared<InstanceTracker>(options.instanceTracker);
+    instanceTracker = rootInstanceTracker;
+    document->root = this;
+    if (loadedYaml.lazyNode) {
+        document->lazyRoot = loadedYaml.lazyNode;
+        document->lazyRootNode = loadedYaml.node;
+    }
 
-cppParser::YamlParser::YamlParser(const YAML::Node& yamlConfiguration, std::string nodePath, std::string type, std::vector<std::filesystem::path> searchDirectories,
-                                  std::weak_ptr<InstanceTracker> instanceTracker)
-    : Factory(std::move(instanceTracker)), type(std::move(type)), nodePath(std::move(nodePath)), yamlConfiguration(yamlConfiguration), searchDirectories(std::move(searchDirectories)) {
-    // store each child in the map with zero usages
-    for (const auto& cn : yamlConfiguration) {
-        nodeUsages[YAML::key_to_string(cn.first)] = 0;
+    // override/add any of the values in the overwriteParameters
+    if (!overwriteParameters.empty()) {
+        OverwritePaths(overwriteParameters).Apply(loadedYaml.node);
     }
 }
 
-cppParser::YamlParser::YamlParser(YAML::Node yamlConfiguration, std::vector<std::filesystem::path> searchDirectories, const std::map<std::string, std::string>& overwriteParameters)
-    : YamlParser(yamlConfiguration, "root", "", std::move(searchDirectories)) {
-    // create the root instance of the tracker
-    rootInstanceTracker = std::make_shared<InstanceTracker>();
-    instanceTracker = rootInstanceTracker;
+cppParser::YamlParser::~YamlParser() {
+    // references can no longer be resolved from the children that outlive the root
+    const YamlParser* self = this;
+    document->root.compare_exchange_strong(self, nullptr);
+}
 
-    // override/add any of the values in the overwriteParameters
-    for (const auto& pair : overwriteParameters) {
-        ReplaceValue(yamlConfiguration, pair.first, pair.second);
+cppParser::YamlParser::YamlParser(YAML::Node yamlConfiguration, std::vector<std::filesystem::path> searchDirectories, const std::map<std::string, std::string>& overwriteParameters,
+                                  const YamlParserOptions& options)
+    : YamlParser(LoadedYaml{.node = std::move(yamlConfiguration), .lazyNode = {}}, std::move(searchDirectories), overwriteParameters, options) {}
+
+cppParser::YamlParser::YamlParser(const std::string& yamlString, std::vector<std::filesystem::path> searchDirectories, const std::map<std::string, std::string>& overwriteParameters,
+                                  const YamlParserOptions& options)
+    : YamlParser(Load(yamlString, options.lazy && overwriteParameters.empty()), std::move(searchDirectories), overwriteParameters, options) {}
+
+cppParser::YamlParser::YamlParser(const std::filesystem::path& filePath, const std::map<std::string, std::string>& overwriteParameters, const YamlParserOptions& options)
+    : YamlParser(Load(filePath, options.lazy && overwriteParameters.empty()), {filePath.parent_path()}, overwriteParameters, options) {}
+
+cppParser::YamlParser::LoadedYaml cppParser::YamlParser::Load(const std::string& yamlString, bool lazy) {
+    if (lazy) {
+        auto text = std::make_shared<const std::string>(yamlString);
+        YAML::Node root;
+        if (auto lazyNode = LazyYamlNode::Scan(text, *text, root)) {
+            return LoadedYaml{.node = root, .lazyNode = lazyNode};
+        }
+    }
+    return LoadedYaml{.node = YAML::Load(yamlString), .lazyNode = {}};
+}
+
+cppParser::YamlParser::LoadedYaml cppParser::YamlParser::Load(const std::filesystem::path& filePath, bool lazy) {
+    if (lazy) {
+        auto file = std::make_shared<MappedFile>(filePath);
+        YAML::Node root;
+        if (auto lazyNode = LazyYamlNode::Scan(file, file->GetView(), root)) {
+            return LoadedYaml{.node = root, .lazyNode = lazyNode};
+        }
+    }
+    return LoadedYaml{.node = YAML::LoadFile(filePath), .lazyNode = {}};
+}
+
+void cppParser::YamlParser::BuildKeyIndex() const {
+    // the yaml-cpp size() call is avoided because it updates a cached size in the node
+    for (const auto& child : yamlConfiguration) {
+        // only scalar keys can be found by name
+        if (yamlConfiguration.IsMap() && child.first.IsScalar()) {
+            const auto& key = child.first.Scalar();
+            keyEntries.push_back(KeyEntry{.hash = std::hash<std::string>{}(key), .key = key, .node = child.second, .position = childCount});
+        }
+        childCount++;
+    }
+
+    if (options.trackUsage) {
+        usages = std::vector<std::atomic<std::uint64_t>>((childCount + 63) / 64);
+    }
+
+    if (keyEntries.size() > keyIndexThreshold) {
+        keyIndex.reserve(keyEntries.size());
+        for (std::size_t i = 0; i < keyEntries.size(); i++) {
+            // keep only the first of any duplicate keys to match the yaml-cpp lookup
+            auto range = keyIndex.equal_range(keyEntries[i].hash);
+            if (std::none_of(range.first, range.second, [this, i](const auto& indexed) { return keyEntries[indexed.second].key == keyEntries[i].key; })) {
+                keyIndex.emplace(keyEntries[i].hash, i);
+            }
+        }
     }
 }
 
-cppParser::YamlParser::YamlParser(const std::string& yamlString, std::vector<std::filesystem::path> searchDirectories, const std::map<std::string, std::string>& overwriteParameters)
-    : YamlParser(YAML::Load(yamlString), std::move(searchDirectories), overwriteParameters) {}
+const cppParser::YamlParser::KeyEntry* cppParser::YamlParser::FindEntry(const std::string& name, std::size_t nameHash) const {
+    std::call_once(keyIndexBuilt, [this] { BuildKeyIndex(); });
 
-cppParser::YamlParser::YamlParser(const std::filesystem::path& filePath, const std::map<std::string, std::string>& overwriteParameters)
-    : YamlParser(YAML::LoadFile(filePath), {filePath.parent_path()}, overwriteParameters) {}
+    if (keyIndex.empty()) {
+        for (const auto& entry : keyEntries) {
+            if (entry.hash == nameHash && entry.key == name) {
+                return &entry;
+            }
+        }
+    } else {
+        auto range = keyIndex.equal_range(nameHash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (keyEntries[it->second].key == name) {
+                return &keyEntries[it->second];
+            }
+        }
+    }
+    return nullptr;
+}
+
+YAML::Node cppParser::YamlParser::FindChild(const std::string& name, std::size_t nameHash, bool materializeAll) const {
+    if (!yamlConfiguration.IsMap()) {
+        return yamlConfiguration[name];
+    }
+
+    const auto found = FindEntry(name, nameHash);
+    if (!found) {
+        return YAML::Node(YAML::NodeType::Undefined);
+    }
+    if (lazyNode) {
+        lazyNode->Materialize(found->key, found->node, materializeAll);
+    }
+    return found->node;
+}
+
+std::shared_ptr<cppParser::YamlParser> cppParser::YamlParser::FindChildFactory(const std::string& name) const {
+    auto lock = ReadLockChildFactories();
+    if (auto childFactory = childFactories.find(name); childFactory != childFactories.end()) {
+        return childFactory->second;
+    }
+    return {};
+}
+
+std::shared_ptr<cppParser::YamlParser> cppParser::YamlParser::StoreChildFactory(const std::string& name, std::shared_ptr<YamlParser> childFactory) const {
+    auto lock = WriteLockChildFactories();
+    return childFactories.try_emplace(name, std::move(childFactory)).first->second;
+}
 
 std::shared_ptr<cppParser::Factory> cppParser::YamlParser::GetFactory(const std::string& name) const {
     // Check to see if the child factory has already been created
-    if (childFactories.count(name) == 0) {
-        if (name.empty()) {
-            auto parameter = yamlConfiguration;
-            auto childPath = nodePath;
-
-            // This is the child, so assume that the tag is empty
-            auto tagType = "";
-
-            // Mark all children here on used, because they will be counted in the child
-            MarkAllUsed();
-            MarkUsage(name);
-            childFactories[name] = std::shared_ptr<YamlParser>(new YamlParser(parameter, childPath, tagType, searchDirectories, instanceTracker));
-        } else {
-            auto parameter = yamlConfiguration[name];
-            auto childPath = nodePath + "/" + name;
+    if (auto childFactory = FindChildFactory(name)) {
+        return childFactory;
+    }
 
-            if (!parameter) {
-                throw std::invalid_argument("unable to find item " + name + " in " + nodePath);
-            }
+    if (name.empty()) {
+        auto parameter = yamlConfiguration;
 
-            auto tagType = parameter.Tag();
-            // Remove the ! or ? from the tag
-            tagType = !tagType.empty() ? tagType.substr(1) : tagType;
+        // This is the child, so assume that the tag is empty
+        auto tagType = "";
 
-            // mark usage and store pointer
-            MarkUsage(name);
-            childFactories[name] = std::shared_ptr<YamlParser>(new YamlParser(parameter, childPath, tagType, searchDirectories, instanceTracker));
+        // Mark all children here on used, because they will be counted in the child
+        MarkAllUsed();
+        return StoreChildFactory(name, std::shared_ptr<YamlParser>(new YamlParser(parameter, location, tagType, searchDirectories, options, instanceTracker, arrayFiles, lazyNode, document)));
+    } else {
+        const auto nameHash = std::hash<std::string>{}(name);
+        auto parameter = FindChild(name, nameHash);
+
+        if (!parameter) {
+            throw std::invalid_argument("unable to find item " + name + " in " + NodePath());
         }
+        return CreateChildFactory(name, nameHash, parameter);
     }
+}
 
-    return childFactories[name];
+std::shared_ptr<cppParser::Factory> cppParser::YamlParser::TryGetFactory(const std::string& name) const {
+    if (name.empty()) {
+        return Factory::TryGetFactory(name);
+    }
+
+    const auto nameHash = std::hash<std::string>{}(name);
+    auto parameter = FindChild(name, nameHash);
+    if (!parameter || parameter.IsNull()) {
+        return nullptr;
+    }
+    if (auto childFactory = FindChildFactory(name)) {
+        return childFactory;
+    }
+    return CreateChildFactory(name, nameHash, parameter);
+}
+
+std::shared_ptr<cppParser::Factory> cppParser::YamlParser::CreateChildFactory(const std::string& name, std::size_t nameHash, const YAML::Node& parameter) const {
+    auto tagType = parameter.Tag();
+    // Remove the ! or ? from the tag
+    tagType = !tagType.empty() ? tagType.substr(1) : tagType;
+
+    // mark usage and store pointer
+    MarkUsage(name, nameHash);
+    if (tagType == "ref") {
+        // the referenced factory is owned by the referenced node, so it is resolved on each use instead of stored
+        return ResolveReference(parameter);
+    }
+    auto childLazyNode = lazyNode ? lazyNode->GetChild(name) : nullptr;
+    auto childLocation = std::make_shared<const NodeLocation>(NodeLocation{.parent = location, .key = name});
+    return StoreChildFactory(
+        name, std::shared_ptr<YamlParser>(new YamlParser(parameter, std::move(childLocation), tagType, searchDirectories, options, instanceTracker, arrayFiles, childLazyNode, document)));
 }
 
 std::vector<std::shared_ptr<cppParser::Factory>> cppParser::YamlParser::GetFactorySequence(const std::string& name) const {
-    auto parameter = name.empty() ? yamlConfiguration : yamlConfiguration[name];
+    const auto nameHash = std::hash<std::string>{}(name);
+
+    // Check to see if the sequence has already been created
+    if (auto sequenceFactories = FindSequenceFactories(name, nameHash)) {
+        return std::move(*sequenceFactories);
+    }
+
+    auto parameter = name.empty() ? yamlConfiguration : FindChild(name, nameHash, true);
     if (!parameter) {
-        throw std::invalid_argument("unable to find list " + name + " in " + nodePath);
+        throw std::invalid_argument("unable to find list " + name + " in " + NodePath());
     }
+    return CreateSequenceFactories(name, nameHash, parameter);
+}
 
-    if (!parameter.IsSequence()) {
-        throw std::invalid_argument("item " + name + " is expected to be a sequence in " + nodePath);
+std::optional<std::vector<std::shared_ptr<cppParser::Factory>>> cppParser::YamlParser::TryGetFactorySequence(const std::string& name) const {
+    if (name.empty()) {
+        return Factory::TryGetFactorySequence(name);
     }
 
-    std::vector<std::shared_ptr<Factory>> children;
+    const auto nameHash = std::hash<std::string>{}(name);
+    auto parameter = FindChild(name, nameHash, true);
+    if (!parameter || parameter.IsNull()) {
+        return std::nullopt;
+    }
+    if (auto sequenceFactories = FindSequenceFactories(name, nameHash)) {
+        return sequenceFactories;
+    }
+    return CreateSequenceFactories(name, nameHash, parameter);
+}
 
-    // march over each child
-    for (std::size_t i = 0; i < parameter.size(); i++) {
-        std::string childName = name + "/" + std::to_string(i);
+std::optional<std::vector<std::shared_ptr<cppParser::Factory>>> cppParser::YamlParser::FindSequenceFactories(const std::string& name, std::size_t nameHash) const {
+    auto lock = ReadLockChildFactories();
+    if (auto sequenceFactory = sequenceFactories.find(name); sequenceFactory != sequenceFactories.end()) {
+        MarkUsage(name, nameHash);
+        return std::vector<std::shared_ptr<Factory>>(sequenceFactory->second.begin(), sequenceFactory->second.end());
+    }
+    return std::nullopt;
+}
 
-        if (childFactories.count(childName) == 0) {
-            auto childParameter = parameter[i];
+std::vector<std::shared_ptr<cppParser::Factory>> cppParser::YamlParser::CreateSequenceFactories(const std::string& name, std::size_t nameHash, const YAML::Node& parameter) const {
+    if (!parameter.IsSequence()) {
+        throw std::invalid_argument("item " + name + " is expected to be a sequence in " + NodePath());
+    }
 
-            if (!childParameter.IsDefined()) {
-                throw std::invalid_argument("item " + childName + " is expected to be a defined in " + nodePath + "/" + name);
-            }
+    // every element shares the location of the sequence
+    auto sequenceLocation = std::make_shared<const NodeLocation>(NodeLocation{.parent = location, .key = name});
+    std::vector<std::shared_ptr<YamlParser>> children;
 
-            std::string childPath = nodePath + "/" + childName;
+    // march over each child, iterating instead of indexing avoids the yaml-cpp size() call that updates a cached size in the node
+    std::size_t i = 0;
+    for (const auto& childParameter : parameter) {
+        auto childLocation = std::make_shared<const NodeLocation>(NodeLocation{.parent = sequenceLocation, .key = {}, .index = i++});
+        if (!childParameter.IsDefined()) {
+            throw std::invalid_argument("item " + name + "/" + std::to_string(childLocation->index) + " is expected to be a defined in " + sequenceLocation->Path());
+        }
 
-            auto tagType = childParameter.Tag();
-            // Remove the ! or ? from the tag
-            tagType = !tagType.empty() ? tagType.substr(1) : tagType;
+        auto tagType = childParameter.Tag();
+        // Remove the ! or ? from the tag
+        tagType = !tagType.empty() ? tagType.substr(1) : tagType;
 
-            // mark usage and store pointer
-            childFactories[childName] = std::shared_ptr<YamlParser>(new YamlParser(childParameter, childPath, tagType, searchDirectories, instanceTracker));
+        if (tagType == "ref") {
+            children.push_back(ResolveReference(childParameter));
+        } else {
+            children.push_back(std::shared_ptr<YamlParser>(new YamlParser(childParameter, std::move(childLocation), tagType, searchDirectories, options, instanceTracker, arrayFiles, {}, document)));
         }
-
-        children.push_back(childFactories[childName]);
     }
 
-    MarkUsage(name);
+    MarkUsage(name, nameHash);
 
-    return children;
+    // If another thread already stored the sequence, use those children instead
+    auto lock = WriteLockChildFactories();
+    const auto& storedChildren = sequenceFactories.try_emplace(name, std::move(children)).first->second;
+    return {storedChildren.begin(), storedChildren.end()};
 }
 
-std::vector<std::string> cppParser::YamlParser::GetUnusedValues() const {
-    std::vector<std::string> unused;
+std::string cppParser::YamlParser::NodeLocation::Path() const {
+    if (!parent) {
+        return key;
+    }
+    return parent->Path() + "/" + (index == std::string::npos ? key : std::to_string(index));
+}
+
+/**
+ * The key as written by yaml-cpp, plain word keys are used directly instead of going through the emitter
+ */
+static std::string KeyName(const YAML::Node& key) {
+    if (!key.IsDefined()) {
+        // the elements of a sequence do not have a key
+        return {};
+    }
+    const auto& scalar = key.Scalar();
+    bool plainWord = key.IsScalar() && (key.Tag() == "?" || key.Tag() == "!") && !scalar.empty() && scalar != "null" && scalar != "Null" && scalar != "NULL" &&
+                     std::all_of(scalar.begin(), scalar.end(), [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+    return plainWord ? scalar : YAML::key_to_string(key);
+}
 
-    for (const auto& children : nodeUsages) {
-        if (children.second == 0) {
-            unused.push_back(nodePath + "/" + children.first);
+void cppParser::YamlParser::AddUnusedValues(const std::string& path, std::vector<std::string>& unused) const {
+    if (!options.trackUsage) {
+        return;
+    }
+    std::call_once(keyIndexBuilt, [this] { BuildKeyIndex(); });
+
+    // the names are only needed when a child is unused
+    auto isUsed = [this](std::size_t position) { return usages[position / 64].load(std::memory_order_relaxed) & (std::uint64_t{1} << (position % 64)); };
+    std::size_t position = 0;
+    while (position < childCount && isUsed(position)) {
+        position++;
+    }
+    if (position < childCount) {
+        // name only the unused children, sorted and without duplicates like the keys
+        std::set<std::string> unusedNames;
+        position = 0;
+        for (const auto& child : yamlConfiguration) {
+            if (!isUsed(position++)) {
+                // a duplicate key is used when the first entry with the key is used
+                const KeyEntry* entry = child.first.IsScalar() ? FindEntry(child.first.Scalar(), std::hash<std::string>{}(child.first.Scalar())) : nullptr;
+                if (!entry || !isUsed(entry->position)) {
+                    unusedNames.insert(KeyName(child.first));
+                }
+            }
+        }
+        for (const auto& name : unusedNames) {
+            unused.push_back(path + "/" + name);
         }
     }
 
-    // Add any unused children from used children
-    for (const auto& childFactory : childFactories) {
-        auto unusedChildren = childFactory.second->GetUnusedValues();
-        unused.insert(std::end(unused), std::begin(unusedChildren), std::end(unusedChildren));
+    // Add any unused children from used children, the sequences are ordered as if each element were stored under "name/index"
+    auto lock = ReadLockChildFactories();
+    auto sequenceFactory = sequenceFactories.begin();
+    auto addSequence = [this, &path, &unused](const std::string& name, const std::vector<std::shared_ptr<YamlParser>>& elements) {
+        for (std::size_t i = 0; i < elements.size(); i++) {
+            // referenced elements are reported by the node they reference
+            if (IsSequenceElement(*elements[i], name, i)) {
+                elements[i]->AddUnusedValues(path + "/" + name + "/" + std::to_string(i), unused);
+            }
+        }
+    };
+    for (const auto& [name, childFactory] : childFactories) {
+        for (; sequenceFactory != sequenceFactories.end() && sequenceFactory->first + "/" < name; ++sequenceFactory) {
+            addSequence(sequenceFactory->first, sequenceFactory->second);
+        }
+        // the child of an empty name is this node
+        childFactory->AddUnusedValues(name.empty() ? path : path + "/" + name, unused);
     }
+    for (; sequenceFactory != sequenceFactories.end(); ++sequenceFactory) {
+        addSequence(sequenceFactory->first, sequenceFactory->second);
+    }
+}
 
+std::vector<std::string> cppParser::YamlParser::GetUnusedValues() const {
+    std::vector<std::string> unused;
+    AddUnusedValues(NodePath(), unused);
     return unused;
 }
 
@@ -132,37 +380,232 @@ std::unordered_set<std::string> cppParser::YamlParser::GetKeys() const {
     return keys;
 }
 
-void cppParser::YamlParser::Print(std::ostream& stream) const { stream << "---" << std::endl << yamlConfiguration << std::endl; }
+std::vector<std::pair<std::string, std::shared_ptr<cppParser::Factory>>> cppParser::YamlParser::GetFactoryEntries() const {
+    std::vector<std::pair<std::string, std::shared_ptr<Factory>>> entries;
+    if (!yamlConfiguration.IsMap()) {
+        return entries;
+    }
 
-void cppParser::YamlParser::ReplaceValue(YAML::Node& yamlConfiguration, const std::string& key, const std::string& value) {
-    // Check to see if there are any separators in the key
-    auto separator = key.find("::");
-    if (separator == std::string::npos) {
-        // Allow the yaml parser to parse the string like normal
-        auto node = YAML::Load(value);
-        yamlConfiguration[key] = node;
-    } else {
-        // strip off the first part of the key and try again
-        auto thisKey = key.substr(0, separator);
-
-        // check to see if this key is an index
-        if (!thisKey.empty() && thisKey[0] == '[' && thisKey.back() == ']') {
-            auto index = std::stoi(thisKey.substr(1, thisKey.size() - 2));
-            auto childConfig = yamlConfiguration[index];
-            ReplaceValue(childConfig, key.substr(separator + 2), value);
+    std::call_once(keyIndexBuilt, [this] { BuildKeyIndex(); });
+    entries.reserve(keyEntries.size());
+    for (const auto& entry : keyEntries) {
+        if (FindEntry(entry.key, entry.hash) != &entry) {
+            continue;
+        }
+
+        std::shared_ptr<Factory> childFactory = FindChildFactory(entry.key);
+        if (!childFactory) {
+            if (lazyNode) {
+                lazyNode->Materialize(entry.key, entry.node, false);
+            }
+            childFactory = CreateChildFactory(entry.key, entry.hash, entry.node);
+        }
+        entries.emplace_back(entry.key, std::move(childFactory));
+    }
+    return entries;
+}
+
+std::size_t cppParser::YamlParser::GetHash() const {
+    auto currentHash = hash.load(std::memory_order_relaxed);
+    if (currentHash) {
+        return currentHash;
+    }
+
+    MaterializeAll();
+    currentHash = ComputeHash();
+    hash.store(currentHash, std::memory_order_relaxed);
+    return currentHash;
+}
+
+std::shared_ptr<cppParser::YamlParser> cppParser::YamlParser::ResolveReference(const YAML::Node& parameter) const {
+    const auto& path = parameter.Scalar();
+    const auto root = document->root.load();
+    if (!root) {
+        throw std::invalid_argument("unable to resolve !ref " + path + " in " + NodePath() + " without the root factory");
+    }
+
+    // a reference that is still being resolved on this thread can never complete
+    static thread_local std::vector<std::string> resolving;
+    if (std::find(resolving.begin(), resolving.end(), path) != resolving.end()) {
+        throw std::invalid_argument("circular !ref " + path + " in " + NodePath());
+    }
+    resolving.push_back(path);
+    struct PopResolving {
+        ~PopResolving() { resolving.pop_back(); }
+    } popResolving;
+
+    std::vector<std::string> segments;
+    for (std::size_t begin = 0; begin <= path.size();) {
+        auto end = std::min(path.find('/', begin), path.size());
+        if (end > begin) {
+            segments.push_back(path.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    if (segments.empty()) {
+        throw std::invalid_argument("the !ref in " + NodePath() + " must name a node below the root");
+    }
+
+    auto toIndex = [&path](const std::string& segment) {
+        if (segment.empty() || !std::all_of(segment.begin(), segment.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            throw std::invalid_argument("unable to resolve !ref " + path + ", " + segment + " is not a sequence index");
+        }
+        try {
+            return std::stoul(segment);
+        } catch (const std::out_of_range&) {
+            throw std::invalid_argument("unable to resolve !ref " + path + ", index " + segment + " is out of range");
+        }
+    };
+    auto element = [&path](const std::vector<std::shared_ptr<Factory>>& elements, std::size_t index) {
+        if (index >= elements.size()) {
+            throw std::invalid_argument("unable to resolve !ref " + path + ", index " + std::to_string(index) + " is out of range");
+        }
+        return std::static_pointer_cast<YamlParser>(elements[index]);
+    };
+
+    // walk down from the root through the stored factories
+    std::shared_ptr<YamlParser> current;
+    const YamlParser* node = root;
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        if (node->yamlConfiguration.IsSequence()) {
+            current = element(node->GetFactorySequence(""), toIndex(segments[i]));
+        } else if (i + 1 < segments.size() && node->FindChild(segments[i], std::hash<std::string>{}(segments[i])).IsSequence()) {
+            current = element(node->GetFactorySequence(segments[i]), toIndex(segments[i + 1]));
+            i++;
         } else {
-            auto childConfig = yamlConfiguration[thisKey];
-            ReplaceValue(childConfig, key.substr(separator + 2), value);
+            current = std::static_pointer_cast<YamlParser>(node->GetFactory(segments[i]));
         }
+        node = current.get();
+    }
+    return current;
+}
+
+/**
+ * Mix the value into the seed hash
+ */
+static inline void HashCombine(std::size_t& seed, std::size_t value) { seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2); }
+
+/**
+ * The hash of the node itself, before the children are combined
+ */
+static inline std::size_t HashNodeHeader(const YAML::Node& node) {
+    std::size_t seed = std::hash<int>{}(node.Type());
+    if (node.IsDefined()) {
+        HashCombine(seed, std::hash<std::string>{}(node.Tag()));
     }
+    return seed;
+}
+
+std::size_t cppParser::YamlParser::HashNode(const YAML::Node& node) {
+    std::size_t seed = HashNodeHeader(node);
+
+    switch (node.Type()) {
+        case YAML::NodeType::Scalar:
+            HashCombine(seed, std::hash<std::string>{}(node.Scalar()));
+            break;
+        case YAML::NodeType::Sequence:
+            for (const auto& child : node) {
+                HashCombine(seed, HashNode(child));
+            }
+            break;
+        case YAML::NodeType::Map:
+            for (const auto& child : node) {
+                HashCombine(seed, HashNode(child.first));
+                HashCombine(seed, HashNode(child.second));
+            }
+            break;
+        default:
+            break;
+    }
+    // zero is reserved to mark an uncomputed hash
+    return std::max<std::size_t>(seed, 1);
+}
+
+std::size_t cppParser::YamlParser::ComputeHash() const {
+    // a child factory is only reused when it was created from this exact node (i.e. not a resolved !ref)
+    auto hashChild = [](const YAML::Node& child, const std::shared_ptr<YamlParser>& childFactory) {
+        return childFactory && childFactory->yamlConfiguration.is(child) ? childFactory->GetHash() : HashNode(child);
+    };
+    auto hashSequence = [&hashChild](const YAML::Node& sequence, const std::vector<std::shared_ptr<YamlParser>>* elementFactories) {
+        std::size_t seed = HashNodeHeader(sequence);
+        std::size_t i = 0;
+        for (const auto& element : sequence) {
+            HashCombine(seed, hashChild(element, elementFactories && i < elementFactories->size() ? (*elementFactories)[i] : nullptr));
+            i++;
+        }
+        return std::max<std::size_t>(seed, 1);
+    };
+    auto findSequenceFactories = [this](const std::string& name) {
+        auto lock = ReadLockChildFactories();
+        auto sequenceFactory = sequenceFactories.find(name);
+        return sequenceFactory != sequenceFactories.end() ? sequenceFactory->second : std::vector<std::shared_ptr<YamlParser>>{};
+    };
+
+    if (yamlConfiguration.IsSequence()) {
+        // the elements of a root sequence are stored without a name
+        auto elementFactories = findSequenceFactories({});
+        return hashSequence(yamlConfiguration, &elementFactories);
+    }
+    if (!yamlConfiguration.IsMap()) {
+        return HashNode(yamlConfiguration);
+    }
+
+    std::size_t seed = HashNodeHeader(yamlConfiguration);
+    for (const auto& child : yamlConfiguration) {
+        HashCombine(seed, HashNode(child.first));
+        if (!child.first.IsScalar()) {
+            HashCombine(seed, HashNode(child.second));
+        } else if (auto childFactory = FindChildFactory(child.first.Scalar()); childFactory || !child.second.IsSequence()) {
+            HashCombine(seed, hashChild(child.second, childFactory));
+        } else {
+            auto elementFactories = findSequenceFactories(child.first.Scalar());
+            HashCombine(seed, hashSequence(child.second, &elementFactories));
+        }
+    }
+    return std::max<std::size_t>(seed, 1);
+}
+
+void cppParser::YamlParser::Print(std::ostream& stream) const {
+    MaterializeAll();
+    stream << "---" << std::endl << yamlConfiguration << std::endl;
+}
+
+void cppParser::YamlParser::WriteBinary(std::ostream& stream) const {
+    MaterializeAll();
+    BinarySerializer::Write(yamlConfiguration, stream);
 }
 
 std::filesystem::path cppParser::YamlParser::Get(const cppParser::ArgumentIdentifier<std::filesystem::path>& identifier) const {
-    if (identifier.optional && !Contains(identifier.inputName)) {
-        return {};
+    if (identifier.optional) {
+        return TryGet(identifier).value_or(std::filesystem::path{});
     }
 
     // get the file locator instance
     auto fileLocator = GetByName<cppParser::PathLocator>(identifier.inputName);
     return fileLocator->Locate(searchDirectories);
 }
+
+std::optional<std::filesystem::path> cppParser::YamlParser::TryGet(const cppParser::ArgumentIdentifier<std::filesystem::path>& identifier) const {
+    if (auto fileLocator = TryGet(ArgumentIdentifier<cppParser::PathLocator>{.inputName = identifier.inputName})) {
+        return (*fileLocator)->Locate(searchDirectories);
+    }
+    return std::nullopt;
+}
+
+template <typename T>
+cppParser::ArrayView<T> cppParser::YamlParser::ConvertParameter(const ArgumentIdentifier<ArrayView<T>>& identifier, const YAML::Node& parameter) const {
+    if (parameter.IsScalar() && parameter.Tag() == "!array") {
+        // the array file is located like any other path in the document
+        auto arrayPath = LocalPath(parameter.Scalar()).Locate(searchDirectories);
+        return arrayFiles->GetView<T>(arrayPath);
+    }
+    return ArrayView<T>(NumericConverter::Convert<std::vector<T>>(parameter));
+}
+
+cppParser::ArrayView<int> cppParser::YamlParser::Get(const ArgumentIdentifier<ArrayView<int>>& identifier) const { return GetValueFromYaml(identifier); }
+
+cppParser::ArrayView<double> cppParser::YamlParser::Get(const ArgumentIdentifier<ArrayView<double>>& identifier) const { return GetValueFromYaml(identifier); }
+
+std::optional<cppParser::ArrayView<int>> cppParser::YamlParser::TryGet(const ArgumentIdentifier<ArrayView<int>>& identifier) const { return TryGetValueFromYaml(identifier); }
+
+std::optional<cppParser::ArrayView<double>> cppParser::YamlParser::TryGet(const ArgumentIdentifier<ArrayView<double>>& identifier) const { return TryGetValueFromYaml(identifier); }
@@ -2,39 +2,259 @@
 #define CPPPARSER_YAMLPARSER_HPP
 
 #include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include "arrayFiles.hpp"
 #include "factory.hpp"
+#include "lazyYamlNode.hpp"
+#include "numericConverter.hpp"
+#include "workStealingExecutor.hpp"
 
 namespace cppParser {
+
+/**
+ * Options used to create a YamlParser.  The options are passed down to every child factory.
+ */
+struct YamlParserOptions {
+    // allow multiple threads to get values and factories from the same document at the same time
+    bool threadSafe = false;
+
+    // create the elements of sequences and maps in parallel, this implies threadSafe
+    bool parallel = false;
+
+    // the executor used when parallel, the shared WorkStealingExecutor is used when not set
+    std::shared_ptr<Executor> executor;
+
+    // when reading a yaml string or file, parse each mapping entry the first time it is used.  Documents with anchors/aliases or that are not a block mapping, and any
+    // document with overwriteParameters, are parsed in full.
+    bool lazy = false;
+
+    // count the use of each value for GetUnusedValues, turn off when the unused values have already been checked and GetUnusedValues then reports nothing
+    bool trackUsage = true;
+
+    // how the root instance tracker holds the created instances, i.e. weakly for a long running service that keeps reloading parts of the document
+    InstanceTrackerOptions instanceTracker;
+};
+
 class YamlParser : public Factory {
    private:
+    /**
+     * The location of a node as its parent and the key or sequence index in the parent.  The "root/key/index" path is only rendered for error messages and unused values.
+     */
+    struct NodeLocation {
+        std::shared_ptr<const NodeLocation> parent;
+        std::string key;
+        // the position in the parent sequence, the key is used when npos
+        std::size_t index = std::string::npos;
+
+        [[nodiscard]] std::string Path() const;
+    };
+
     const std::string type;
-    const std::string nodePath;
+    const std::shared_ptr<const NodeLocation> location;
     const YAML::Node yamlConfiguration;
-    mutable std::map<std::string, int> nodeUsages;
+    const YamlParserOptions options;
     mutable std::map<std::string, std::shared_ptr<YamlParser>> childFactories;
+    // the elements of each sequence by the sequence name
+    mutable std::map<std::string, std::vector<std::shared_ptr<YamlParser>>> sequenceFactories;
     const std::vector<std::filesystem::path> searchDirectories;
 
+    // guards childFactories and sequenceFactories, only created when options.threadSafe or options.parallel is set
+    const std::unique_ptr<std::shared_mutex> childFactoriesMutex;
+
+    // the unparsed entries when this node is a lazily parsed mapping
+    const std::shared_ptr<const LazyYamlNode> lazyNode;
+
+    // the array files mapped for !array values, created by the root and shared with every child
+    const std::shared_ptr<ArrayFiles> arrayFiles;
+
+    /**
+     * The state shared by every factory created from the same root
+     */
+    struct SharedDocument {
+        // the root factory used to resolve !ref paths, cleared when the root is destroyed.  The children do not own the root, so the root must outlive any !ref
+        // resolution: a resolution after the root is destroyed throws, one that races with the destruction of the root is undefined.
+        std::atomic<const YamlParser*> root = nullptr;
+
+        // the root mapping when the document is parsed lazily, used to report conversion errors at their position in the file
+        std::shared_ptr<const LazyYamlNode> lazyRoot;
+        YAML::Node lazyRootNode;
+    };
+    const std::shared_ptr<SharedDocument> document;
+
     // The root YamlParser should store a shared ptr to a     mutable std::weak_ptr<InstanceTracker> instanceTracker;
     std::shared_ptr<InstanceTracker> rootInstanceTracker;
 
+    /**
+     * A map key in this node with its precomputed hash
+     */
+    struct KeyEntry {
+        std::size_t hash;
+        std::string key;
+        YAML::Node node;
+        // the position of the child in the node, used to mark the usage
+        std::size_t position;
+    };
+
+    /**
+     * The keys in this node (in document order) and an index from the key hash to the keyEntries position.  Both are built the first time the node is queried.
+     */
+    mutable std::vector<KeyEntry> keyEntries;
+    mutable std::unordered_multimap<std::size_t, std::size_t> keyIndex;
+    mutable std::once_flag keyIndexBuilt;
+
+    /**
+     * One usage bit for each child by position, created with the keyIndex when options.trackUsage is set.  The bits are set without locking.
+     */
+    mutable std::size_t childCount = 0;
+    mutable std::vector<std::atomic<std::uint64_t>> usages;
+
+    /**
+     * Maps with up to this many keys are searched by comparing the stored hashes directly instead of building the keyIndex
+     */
+    static constexpr std::size_t keyIndexThreshold = 16;
+
+    /**
+     * The structural hash of the yamlConfiguration, computed on first use.  Zero marks an uncomputed hash.
+     */
+    mutable std::atomic<std::size_t> hash = 0;
+
+    /**
+     * Compute the structural (Merkle) hash of a node from its tag, scalar value, and children.  Zero is never returned so that it can mark an uncomputed hash.
+     */
+    static std::size_t HashNode(const YAML::Node& node);
+
+    /**
+     * Compute the hash of the yamlConfiguration, reusing the cached hashes of the child factories already created from its children.  The result matches HashNode.
+     */
+    std::size_t ComputeHash() const;
+
     /***
      * private constructor to create a sub factory
      * @param yamlConfiguration
-     * @param nodePath
+     * @param location
      * @param type
      */
-    YamlParser(const YAML::Node& yamlConfiguration, std::string nodePath, std::string type, std::vector<std::filesystem::path> searchDirectories, std::weak_ptr<InstanceTracker> instanceTracker = {});
-    inline void MarkUsage(const std::string& key) const { nodeUsages[key]++; }
+    YamlParser(const YAML::Node& yamlConfiguration, std::shared_ptr<const NodeLocation> location, std::string type, std::vector<std::filesystem::path> searchDirectories,
+               const YamlParserOptions& options, std::weak_ptr<InstanceTracker> instanceTracker = {}, std::shared_ptr<ArrayFiles> arrayFiles = {},
+               std::shared_ptr<const LazyYamlNode> lazyNode = {}, std::shared_ptr<SharedDocument> document = {});
+
+    /**
+     * A loaded yaml document, the lazyNode is only set when the document is parsed lazily
+     */
+    struct LoadedYaml {
+        YAML::Node node;
+        std::shared_ptr<const LazyYamlNode> lazyNode;
+    };
+
+    /**
+     * Load the yaml text, scanning it for lazy parsing when requested
+     */
+    static LoadedYaml Load(const std::string& yamlString, bool lazy);
+    static LoadedYaml Load(const std::filesystem::path& filePath, bool lazy);
+
+    /***
+     * private constructor for the root factory
+     */
+    YamlParser(LoadedYaml loadedYaml, std::vector<std::filesystem::path> searchDirectories, const std::map<std::string, std::string>& overwriteParameters,
+               const YamlParserOptions& options);
+
+    /**
+     * Mark the child as used.  The elements of a sequence are all reported under the empty key.
+     * @param key
+     * @param keyHash std::hash of the key
+     */
+    inline void MarkUsage(const std::string& key, std::size_t keyHash) const {
+        if (!options.trackUsage) {
+            return;
+        }
+        if (!yamlConfiguration.IsMap()) {
+            if (key.empty()) {
+                MarkAllUsed();
+            }
+            return;
+        }
+        if (auto entry = FindEntry(key, keyHash)) {
+            usages[entry->position / 64].fetch_or(std::uint64_t{1} << (entry->position % 64), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Lock the childFactories for reading/writing.  The locks are empty when not thread safe.
+     */
+    inline std::shared_lock<std::shared_mutex> ReadLockChildFactories() const {
+        return childFactoriesMutex ? std::shared_lock<std::shared_mutex>(*childFactoriesMutex) : std::shared_lock<std::shared_mutex>();
+    }
+    inline std::unique_lock<std::shared_mutex> WriteLockChildFactories() const {
+        return childFactoriesMutex ? std::unique_lock<std::shared_mutex>(*childFactoriesMutex) : std::unique_lock<std::shared_mutex>();
+    }
+
+    /**
+     * Find a previously created child factory
+     */
+    std::shared_ptr<YamlParser> FindChildFactory(const std::string& name) const;
+
+    /**
+     * Store the child factory.  If another thread already stored a child under the same name, that child is returned instead.
+     */
+    std::shared_ptr<YamlParser> StoreChildFactory(const std::string& name, std::shared_ptr<YamlParser> childFactory) const;
+
+    /**
+     * The path of this node, i.e. root/key/index
+     */
+    [[nodiscard]] inline std::string NodePath() const { return location->Path(); }
+
+    /**
+     * Add the unused values in this node and the child factories using the already rendered path of this node
+     */
+    void AddUnusedValues(const std::string& path, std::vector<std::string>& unused) const;
+
+    /**
+     * Build the keyEntries/keyIndex and the usages for this node
+     */
+    void BuildKeyIndex() const;
+
+    /**
+     * Find the map key entry using the precomputed hash
+     * @return the entry or nullptr
+     */
+    const KeyEntry* FindEntry(const std::string& name, std::size_t nameHash) const;
+
+    /**
+     * Find the named child using the precomputed hash.  Only maps are indexed, all other nodes use the yaml-cpp lookup.
+     * @param name
+     * @param nameHash std::hash of the name
+     * @param materializeAll when lazily parsed, parse every nested mapping in the child instead of just the child
+     * @return the child node or an undefined node
+     */
+    YAML::Node FindChild(const std::string& name, std::size_t nameHash, bool materializeAll = false) const;
+
+    /**
+     * Parse any lazily parsed entries in this node
+     */
+    inline void MaterializeAll() const {
+        if (lazyNode) {
+            lazyNode->MaterializeAll(yamlConfiguration);
+        }
+    }
 
     /**
      * Marks all of the keys used.
      */
     void MarkAllUsed() const override {
-        for (auto& pairs : nodeUsages) {
-            pairs.second++;
+        if (!options.trackUsage) {
+            return;
+        }
+        std::call_once(keyIndexBuilt, [this] { BuildKeyIndex(); });
+        for (auto& usage : usages) {
+            usage.store(~std::uint64_t{0}, std::memory_order_relaxed);
         }
     }
 
@@ -45,14 +265,158 @@ class YamlParser : public Factory {
     inline YAML::Node GetParameter(const ArgumentIdentifier<T>& identifier) const {
         // treat this yamlConfiguration as the item if the identifier is default
         if (identifier.inputName.empty()) {
+            MaterializeAll();
             return yamlConfiguration;
         } else if (yamlConfiguration.IsMap()) {
-            return yamlConfiguration[identifier.inputName];
+            return FindChild(identifier.inputName, identifier.inputNameHash, true);
         } else {
             return YAML::Node(YAML::NodeType::Undefined);
         }
     }
 
+    /**
+     * Convert the located parameter to the value type
+     */
+    template <typename T>
+    inline T ConvertParameter(const ArgumentIdentifier<T>& identifier, const YAML::Node& parameter) const {
+        if constexpr (NumericConverter::IsConvertible<T>::value) {
+            return NumericConverter::Convert<T>(parameter);
+        } else {
+            return parameter.template as<T>();
+        }
+    }
+
+    /**
+     * A sequence is merged into a single space separated string
+     */
+    inline std::string ConvertParameter(const ArgumentIdentifier<std::string>& identifier, const YAML::Node& parameter) const {
+        if (parameter.IsSequence()) {
+            // Merge the results into a single space separated string
+            std::stringstream ss;
+            for (const auto& v : parameter) {
+                ss << v.template as<std::string>() << " ";
+            }
+            return ss.str();
+        } else {
+            return parameter.template as<std::string>();
+        }
+    }
+
+    /**
+     * Fill the matrix from a sequence of equal length sequences using a single allocation
+     */
+    template <typename T>
+    inline Matrix<T> ConvertParameter(const ArgumentIdentifier<Matrix<T>>& identifier, const YAML::Node& parameter) const {
+        if (!parameter.IsSequence()) {
+            throw std::invalid_argument("item " + identifier.inputName + " is expected to be a sequence in " + NodePath());
+        }
+
+        // count with the iterators, size() updates a cached size in the node
+        const std::size_t rows = std::distance(parameter.begin(), parameter.end());
+        const std::size_t columns = rows ? std::distance((*parameter.begin()).begin(), (*parameter.begin()).end()) : 0;
+
+        std::vector<T> values;
+        values.reserve(rows * columns);
+        for (const auto& row : parameter) {
+            std::size_t rowColumns = 0;
+            if (row.IsSequence()) {
+                for (const auto& element : row) {
+                    if (++rowColumns > columns) {
+                        break;
+                    }
+                    if constexpr (NumericConverter::IsConvertible<T>::value) {
+                        values.push_back(NumericConverter::Convert<T>(element));
+                    } else {
+                        values.push_back(element.template as<T>());
+                    }
+                }
+            }
+            if (!row.IsSequence() || rowColumns != columns) {
+                throw std::invalid_argument("item " + identifier.inputName + " in " + NodePath() + " is expected to be a matrix with rows of " + std::to_string(columns) + " values");
+            }
+        }
+        return Matrix<T>(rows, columns, std::move(values));
+    }
+
+    /**
+     * View a binary array file tagged !array, or copy an inline sequence into the view
+     */
+    template <typename T>
+    ArrayView<T> ConvertParameter(const ArgumentIdentifier<ArrayView<T>>& identifier, const YAML::Node& parameter) const;
+
+    /**
+     * The item converted for each element of a sequence (or value of a map) when locating a conversion error
+     */
+    template <typename T>
+    struct ConversionElement {
+        using type = void;
+        static constexpr bool map = false;
+    };
+
+    template <typename T>
+    struct ConversionElement<std::vector<T>> {
+        using type = T;
+        static constexpr bool map = false;
+    };
+
+    template <typename T>
+    struct ConversionElement<Matrix<T>> {
+        using type = std::vector<T>;
+        static constexpr bool map = false;
+    };
+
+    template <typename T>
+    struct ConversionElement<ArrayView<T>> {
+        using type = T;
+        static constexpr bool map = false;
+    };
+
+    template <typename T>
+    struct ConversionElement<std::map<std::string, T>> {
+        using type = T;
+        static constexpr bool map = true;
+    };
+
+    /**
+     * Throw a conversion error from a lazily parsed document again at the position of the failing node in the file.  Returns when the node cannot be located.
+     */
+    template <typename T>
+    void ThrowLazyBadConversion(const YAML::Node& parameter) const {
+        // a sequence is merged into a single string
+        using Element = std::conditional_t<std::is_same_v<T, std::string>, std::string, typename ConversionElement<T>::type>;
+        if constexpr (!std::is_void_v<Element>) {
+            constexpr bool map = ConversionElement<T>::map;
+            if (map ? parameter.IsMap() : parameter.IsSequence()) {
+                for (const auto& item : parameter) {
+                    const YAML::Node& value = map ? item.second : item;
+                    try {
+                        value.template as<Element>();
+                    } catch (const YAML::BadConversion&) {
+                        ThrowLazyBadConversion<Element>(value);
+                    }
+                }
+            }
+        }
+        if (auto mark = document->lazyRoot->FindMark(document->lazyRootNode, parameter)) {
+            throw YAML::TypedBadConversion<T>(*mark);
+        }
+    }
+
+    /**
+     * Convert the located parameter, the marks of lazily parsed nodes count lines from the start of their entry so the errors are located in the file
+     */
+    template <typename T>
+    inline T ConvertLocatedParameter(const ArgumentIdentifier<T>& identifier, const YAML::Node& parameter) const {
+        try {
+            return ConvertParameter(identifier, parameter);
+        } catch (const YAML::BadConversion&) {
+            if (document->lazyRoot) {
+                ThrowLazyBadConversion<T>(parameter);
+            }
+            throw;
+        }
+    }
+
     template <typename T>
     inline T GetValueFromYaml(const ArgumentIdentifier<T>& identifier) const {
         // treat this yamlConfiguration as the item if the identifier is default
@@ -61,62 +425,81 @@ class YamlParser : public Factory {
             if (identifier.optional) {
                 return {};
             } else {
-                throw std::invalid_argument("unable to locate " + identifier.inputName + " in " + nodePath);
+                throw std::invalid_argument("unable to locate " + identifier.inputName + " in " + NodePath());
             }
         }
-        MarkUsage(identifier.inputName);
-        return parameter.template as<T>();
+        MarkUsage(identifier.inputName, identifier.inputNameHash);
+        return ConvertLocatedParameter(identifier, parameter);
+    }
+
+    /**
+     * Locate the parameter once, null values are not contained
+     */
+    template <typename T>
+    inline std::optional<T> TryGetValueFromYaml(const ArgumentIdentifier<T>& identifier) const {
+        auto parameter = GetParameter(identifier);
+        if (!parameter || parameter.IsNull()) {
+            return std::nullopt;
+        }
+        MarkUsage(identifier.inputName, identifier.inputNameHash);
+        return ConvertLocatedParameter(identifier, parameter);
+    }
+
+    /**
+     * Resolve a "!ref path/to/node" value to the factory of the node at that path from the root.  The factory is shared with the referenced node, so the instances created
+     * from it are reused and the referenced values are marked used.  Sequence elements are named by their index, i.e. "path/to/list/0".  The root factory must still be
+     * alive, see SharedDocument.
+     */
+    std::shared_ptr<YamlParser> ResolveReference(const YAML::Node& parameter) const;
+
+    /**
+     * A sequence element that is owned by (and reports its unused values under) this node rather than resolved from a !ref
+     */
+    [[nodiscard]] inline bool IsSequenceElement(const YamlParser& element, const std::string& name, std::size_t index) const {
+        return element.location->index == index && element.location->parent && element.location->parent->parent == location && element.location->parent->key == name;
     }
 
     /**
-     * recursive call to update parameters
+     * Create and store the child factory for a located map entry
+     */
+    std::shared_ptr<Factory> CreateChildFactory(const std::string& name, std::size_t nameHash, const YAML::Node& parameter) const;
+
+    /**
+     * Find the previously created sequence, the usage is marked when found
      */
-    static void ReplaceValue(YAML::Node& yamlConfiguration, const std::string& key, const std::string& value);
+    std::optional<std::vector<std::shared_ptr<Factory>>> FindSequenceFactories(const std::string& name, std::size_t nameHash) const;
+
+    /**
+     * Create and store the child factories for a located sequence
+     */
+    std::vector<std::shared_ptr<Factory>> CreateSequenceFactories(const std::string& name, std::size_t nameHash, const YAML::Node& parameter) const;
 
    public:
-    explicit YamlParser(YAML::Node yamlConfiguration, std::vector<std::filesystem::path> searchDirectories = {}, const std::map<std::string, std::string>& overwriteParameters = {});
-    ~YamlParser() override = default;
+    explicit YamlParser(YAML::Node yamlConfiguration, std::vector<std::filesystem::path> searchDirectories = {}, const std::map<std::string, std::string>& overwriteParameters = {},
+                        const YamlParserOptions& options = {});
+    ~YamlParser() override;
 
     // allow derived access to all Get
     using cppParser::Factory::Get;
+    using cppParser::Factory::TryGet;
     /***
      * Direct creation using a yaml string
      * @param yamlString
      */
-    explicit YamlParser(const std::string& yamlString, std::vector<std::filesystem::path> searchDirectories = {}, const std::map<std::string, std::string>& overwriteParameters = {});
+    explicit YamlParser(const std::string& yamlString, std::vector<std::filesystem::path> searchDirectories = {}, const std::map<std::string, std::string>& overwriteParameters = {},
+                        const YamlParserOptions& options = {});
 
     /***
      * Read in file from system
      * @param filePath
      */
-    explicit YamlParser(const std::filesystem::path& filePath, const std::map<std::string, std::string>& overwriteParameters = {});
+    explicit YamlParser(const std::filesystem::path& filePath, const std::map<std::string, std::string>& overwriteParameters = {}, const YamlParserOptions& options = {});
 
     /* gets the class type represented by this factory */
     const std::string& GetClassType() const override { return type; }
 
     /* return a string*/
-    std::string Get(const ArgumentIdentifier<std::string>& identifier) const override {
-        // treat this yamlConfiguration as the item if the identifier is default
-        auto parameter = GetParameter(identifier);
-        if (!parameter) {
-            if (identifier.optional) {
-                return {};
-            } else {
-                throw std::invalid_argument("unable to locate " + identifier.inputName + " in " + nodePath);
-            }
-        }
-        MarkUsage(identifier.inputName);
-        if (parameter.IsSequence()) {
-            // Merge the results into a single space separated string
-            std::stringstream ss;
-            for (const auto& v : parameter) {
-                ss << v.template as<std::string>() << " ";
-            }
-            return ss.str();
-        } else {
-            return parameter.template as<std::string>();
-        }
-    }
+    std::string Get(const ArgumentIdentifier<std::string>& identifier) const override { return GetValueFromYaml(identifier); }
 
     bool Get(const ArgumentIdentifier<bool>& identifier) const override { return GetValueFromYaml<bool>(identifier); };
 
@@ -160,33 +543,108 @@ class YamlParser : public Factory {
     /* return an int for the specified identifier*/
     int Get(const ArgumentIdentifier<int>& identifier) const override { return GetValueFromYaml<int>(identifier); }
 
+    Matrix<int> Get(const ArgumentIdentifier<Matrix<int>>& identifier) const override { return GetValueFromYaml(identifier); }
+
+    Matrix<double> Get(const ArgumentIdentifier<Matrix<double>>& identifier) const override { return GetValueFromYaml(identifier); }
+
+    Matrix<std::string> Get(const ArgumentIdentifier<Matrix<std::string>>& identifier) const override { return GetValueFromYaml(identifier); }
+
+    ArrayView<int> Get(const ArgumentIdentifier<ArrayView<int>>& identifier) const override;
+
+    ArrayView<double> Get(const ArgumentIdentifier<ArrayView<double>>& identifier) const override;
+
+    std::optional<std::string> TryGet(const ArgumentIdentifier<std::string>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<int> TryGet(const ArgumentIdentifier<int>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<bool> TryGet(const ArgumentIdentifier<bool>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<double> TryGet(const ArgumentIdentifier<double>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<std::vector<std::string>> TryGet(const ArgumentIdentifier<std::vector<std::string>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<std::vector<int>> TryGet(const ArgumentIdentifier<std::vector<int>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<std::vector<double>> TryGet(const ArgumentIdentifier<std::vector<double>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<std::vector<std::vector<int>>> TryGet(const ArgumentIdentifier<std::vector<std::vector<int>>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<std::vector<std::vector<double>>> TryGet(const ArgumentIdentifier<std::vector<std::vector<double>>>& identifier) const override {
+        return TryGetValueFromYaml(identifier);
+    }
+
+    std::optional<std::vector<std::vector<std::string>>> TryGet(const ArgumentIdentifier<std::vector<std::vector<std::string>>>& identifier) const override {
+        return TryGetValueFromYaml(identifier);
+    }
+
+    std::optional<std::map<std::string, std::string>> TryGet(const ArgumentIdentifier<std::map<std::string, std::string>>& identifier) const override {
+        return TryGetValueFromYaml(identifier);
+    }
+
+    std::optional<Matrix<int>> TryGet(const ArgumentIdentifier<Matrix<int>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<Matrix<double>> TryGet(const ArgumentIdentifier<Matrix<double>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<Matrix<std::string>> TryGet(const ArgumentIdentifier<Matrix<std::string>>& identifier) const override { return TryGetValueFromYaml(identifier); }
+
+    std::optional<ArrayView<int>> TryGet(const ArgumentIdentifier<ArrayView<int>>& identifier) const override;
+
+    std::optional<ArrayView<double>> TryGet(const ArgumentIdentifier<ArrayView<double>>& identifier) const override;
+
+    std::optional<std::filesystem::path> TryGet(const ArgumentIdentifier<std::filesystem::path>& identifier) const override;
+
     /* return a factory that serves as the root of the requested item */
     std::shared_ptr<Factory> GetFactory(const std::string& name) const override;
 
     /* get all children as factory */
     std::vector<std::shared_ptr<Factory>> GetFactorySequence(const std::string& name) const override;
 
-    bool Contains(const std::string& name) const override { return yamlConfiguration.IsMap() && yamlConfiguration[name].IsDefined() && !yamlConfiguration[name].IsNull(); };
+    std::shared_ptr<Factory> TryGetFactory(const std::string& name) const override;
+
+    std::optional<std::vector<std::shared_ptr<Factory>>> TryGetFactorySequence(const std::string& name) const override;
+
+    bool Contains(const std::string& name) const override {
+        if (!yamlConfiguration.IsMap()) {
+            return false;
+        }
+        auto child = FindChild(name, std::hash<std::string>{}(name));
+        return child.IsDefined() && !child.IsNull();
+    };
 
     std::unordered_set<std::string> GetKeys() const override;
 
+    /* visit the map keys once in document order, duplicate keys return the first entry like GetFactory */
+    std::vector<std::pair<std::string, std::shared_ptr<Factory>>> GetFactoryEntries() const override;
+
     /** get unused values **/
     std::vector<std::string> GetUnusedValues() const override;
 
     /** print a copy of the yaml input as updated **/
     void Print(std::ostream&) const;
 
+    /** write a copy of the yaml input as updated to the binary format read by the MappedFactory **/
+    void WriteBinary(std::ostream&) const;
+
     /** provide comparison between factories **/
     virtual bool SameFactory(const Factory& otherFactory) const override {
         const auto otherFactoryPtr = dynamic_cast<const YamlParser*>(&otherFactory);
 
         if (otherFactoryPtr) {
+            // different cached hashes mean different nodes, otherwise the node identity decides
+            auto thisHash = hash.load(std::memory_order_relaxed);
+            auto otherHash = otherFactoryPtr->hash.load(std::memory_order_relaxed);
+            if (thisHash && otherHash && thisHash != otherHash) {
+                return false;
+            }
             return yamlConfiguration == otherFactoryPtr->yamlConfiguration;
         } else {
             return false;
         }
     }
 
+    /** return the cached structural hash of the yamlConfiguration **/
+    std::size_t GetHash() const override;
+
     /**
      * returns the path to a file as specified using a file locator instance.  This override allows searching in search directories
      * @param identifier
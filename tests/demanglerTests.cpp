@@ -0,0 +1,61 @@
+#include <memory>
+#include "demangler.hpp"
+#include "gtest/gtest.h"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+class DemanglerMockClass {};
+
+enum class DemanglerMockEnum { A, B };
+
+template <typename T>
+class DemanglerMockTemplate {};
+
+namespace {
+class DemanglerAnonymousMockClass {};
+}  // namespace
+
+static_assert(Demangler::TypeName<DemanglerMockClass>() == "cppParserTesting::DemanglerMockClass");
+static_assert(Demangler::TypeName<DemanglerMockEnum>() == "cppParserTesting::DemanglerMockEnum");
+
+TEST(DemanglerTests, ShouldMatchRuntimeNameForCompileTimeNames) {
+    // arrange
+    // act
+    // assert
+    ASSERT_EQ(Demangler::Demangle(typeid(DemanglerMockClass).name()), Demangler::Demangle<DemanglerMockClass>());
+    ASSERT_EQ(Demangler::Demangle(typeid(DemanglerMockEnum).name()), Demangler::Demangle<DemanglerMockEnum>());
+    ASSERT_EQ(Demangler::Demangle(typeid(DemanglerMockTemplate<int>).name()), Demangler::Demangle<DemanglerMockTemplate<int>>());
+    ASSERT_EQ(Demangler::Demangle(typeid(DemanglerAnonymousMockClass).name()), Demangler::Demangle<DemanglerAnonymousMockClass>());
+    ASSERT_EQ(Demangler::Demangle(typeid(long).name()), Demangler::Demangle<long>());
+}
+
+TEST(DemanglerTests, ShouldUsePrettyNames) {
+    // arrange
+    // act
+    // assert
+    ASSERT_EQ("string", Demangler::Demangle<std::string>());
+    ASSERT_EQ("file path or url", Demangler::Demangle<std::filesystem::path>());
+    ASSERT_EQ("int list", Demangler::Demangle<std::vector<int>>());
+    ASSERT_EQ("cppParserTesting::DemanglerMockClass list", Demangler::Demangle<std::vector<DemanglerMockClass>>());
+    ASSERT_EQ("string,cppParserTesting::DemanglerMockClass map", (Demangler::Demangle<std::map<std::string, DemanglerMockClass>>()));
+    ASSERT_EQ("string,cppParserTesting::DemanglerMockClass map", (Demangler::Demangle<OrderedMap<std::string, DemanglerMockClass>>()));
+    ASSERT_EQ("double matrix", Demangler::Demangle<Matrix<double>>());
+    ASSERT_EQ("string matrix", Demangler::Demangle<Matrix<std::string>>());
+    ASSERT_EQ("int array", Demangler::Demangle(typeid(ArrayView<int>).name()));
+    ASSERT_EQ("argument map", Demangler::Demangle(typeid(std::map<std::string, std::string>).name()));
+}
+
+TEST(DemanglerTests, ShouldBuildEachNameOnce) {
+    // arrange
+    // act
+    auto name = Demangler::Demangle<std::vector<DemanglerMockClass>>();
+    auto sameName = Demangler::Demangle<std::vector<DemanglerMockClass>>();
+
+    // assert
+    ASSERT_EQ(name.data(), sameName.data());
+    ASSERT_EQ(Demangler::Demangle<DemanglerMockTemplate<int>>().data(), Demangler::Demangle<DemanglerMockTemplate<int>>().data());
+}
+
+}  // namespace cppParserTesting
@@ -204,6 +204,69 @@ TEST(FactoryTests, ShouldReturnEnumFromStringList) {
     ASSERT_EQ(result[2], TestEnum::VECTOR);
 }
 
+TEST(FactoryTests, ShouldReturnMatrixFromVectorOfVectors) {
+    // arrange
+    auto mockFactory = std::make_shared<MockFactory>();
+    EXPECT_CALL(*mockFactory, Get(ArgumentIdentifier<std::vector<std::vector<double>>>{.inputName = "input123"}))
+        .Times(::testing::Exactly(1))
+        .WillOnce(::testing::Return(std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}}));
+
+    // act
+    auto argument = ArgumentIdentifier<Matrix<double>>{.inputName = "input123", .optional = false};
+    auto result = std::dynamic_pointer_cast<Factory>(mockFactory)->Get(argument);
+
+    // assert
+    ASSERT_EQ(2, result.Rows());
+    ASSERT_EQ(3, result.Columns());
+    ASSERT_EQ((std::vector<double>{1, 2, 3, 4, 5, 6}), std::vector<double>(result.data(), result.data() + result.size()));
+}
+
+TEST(FactoryTests, ShouldThrowForNonRectangularMatrix) {
+    // arrange
+    auto mockFactory = std::make_shared<MockFactory>();
+    EXPECT_CALL(*mockFactory, Get(ArgumentIdentifier<std::vector<std::vector<int>>>{.inputName = "input123"}))
+        .Times(::testing::Exactly(1))
+        .WillOnce(::testing::Return(std::vector<std::vector<int>>{{1, 2}, {3}}));
+
+    // act
+    // assert
+    auto argument = ArgumentIdentifier<Matrix<int>>{.inputName = "input123", .optional = false};
+    ASSERT_THROW(std::dynamic_pointer_cast<Factory>(mockFactory)->Get(argument), std::invalid_argument);
+}
+
+TEST(FactoryTests, TryGetShouldCheckContainsBeforeGet) {
+    // arrange
+    MockFactory mockFactory;
+    EXPECT_CALL(mockFactory, Contains("input123")).Times(::testing::Exactly(1)).WillOnce(::testing::Return(true));
+    EXPECT_CALL(mockFactory, Contains("input456")).Times(::testing::Exactly(1)).WillOnce(::testing::Return(false));
+    EXPECT_CALL(mockFactory, Get(ArgumentIdentifier<int>{.inputName = "input123"})).Times(::testing::Exactly(1)).WillOnce(::testing::Return(123));
+
+    // act
+    auto result = mockFactory.TryGet(ArgumentIdentifier<int>{.inputName = "input123"});
+    auto missingResult = mockFactory.TryGet(ArgumentIdentifier<int>{.inputName = "input456"});
+
+    // assert
+    ASSERT_EQ(123, result);
+    ASSERT_FALSE(missingResult.has_value());
+}
+
+TEST(FactoryTests, TryGetShouldReturnNulloptForMissingInterface) {
+    // arrange
+    cppParser::Registrar<FactoryMockClass1>::Register<FactoryMockClass1>(true, "FactoryMockClass1", "this is a simple mock class");
+    auto mockFactory = std::make_shared<MockFactory>();
+    EXPECT_CALL(*mockFactory, Contains(std::string("input123"))).Times(::testing::Exactly(3)).WillRepeatedly(::testing::Return(false));
+
+    // act
+    auto result = mockFactory->TryGet(ArgumentIdentifier<FactoryMockClass1>{.inputName = "input123"});
+    auto listResult = mockFactory->TryGet(ArgumentIdentifier<std::vector<FactoryMockClass1>>{.inputName = "input123"});
+    auto mapResult = mockFactory->TryGet(ArgumentIdentifier<std::map<std::string, FactoryMockClass1>>{.inputName = "input123"});
+
+    // assert
+    ASSERT_FALSE(result.has_value());
+    ASSERT_FALSE(listResult.has_value());
+    ASSERT_FALSE(mapResult.has_value());
+}
+
 TEST(FactoryTests, ShouldGetMapOfSharedPointers) {
     // arrange
     const std::string defaultClassType = "FactoryMockClass1";
@@ -233,6 +296,31 @@ TEST(FactoryTests, ShouldGetMapOfSharedPointers) {
     ASSERT_TRUE(std::dynamic_pointer_cast<FactoryMockClass1>(result["key2"]) != nullptr);
 }
 
+TEST(FactoryTests, ShouldGetOrderedMapOfSharedPointersFromKeys) {
+    // arrange
+    const std::string defaultClassType = "FactoryMockClass1";
+    cppParser::Registrar<FactoryMockClass1>::Register<FactoryMockClass1>(true, std::string(defaultClassType), "this is a simple mock class");
+    auto mockFactory = std::make_shared<MockFactory>();
+
+    // subChildFactory
+    auto subChildFactory = std::make_shared<MockFactory>();
+    EXPECT_CALL(*mockFactory, GetFactory("input123")).Times(::testing::Exactly(1)).WillOnce(::testing::Return(subChildFactory));
+    EXPECT_CALL(*subChildFactory, GetKeys()).Times(::testing::Exactly(1)).WillOnce(::testing::Return(std::unordered_set<std::string>{"key1"}));
+
+    auto factoryChild1 = std::make_shared<MockFactory>();
+    EXPECT_CALL(*subChildFactory, GetFactory("key1")).Times(::testing::Exactly(1)).WillOnce(::testing::Return(factoryChild1));
+    EXPECT_CALL(*factoryChild1, GetClassType()).Times(::testing::Exactly(1)).WillOnce(::testing::ReturnRef(defaultClassType));
+
+    // act
+    auto argument = ArgumentIdentifier<OrderedMap<std::string, FactoryMockClass1>>{.inputName = "input123", .optional = false};
+    auto result = std::dynamic_pointer_cast<Factory>(mockFactory)->Get(argument);
+
+    // assert
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_EQ(result.begin()->first, "key1");
+    ASSERT_TRUE(std::dynamic_pointer_cast<FactoryMockClass1>(result.at("key1")) != nullptr);
+}
+
 /**
  * Create multi level inheritance
  */
@@ -0,0 +1,159 @@
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include "binarySerializer.hpp"
+#include "gtest/gtest.h"
+#include "inSituYamlReader.hpp"
+#include "mappedFactory.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+namespace fs = std::filesystem;
+
+/**
+ * Load the yaml string with yaml-cpp into a flat document for comparison
+ */
+static std::shared_ptr<const FlatDocument> ReadWithYamlCpp(const std::string& yaml) {
+    fs::path tempPath = fs::temp_directory_path() / "inSituYamlReaderExpected.bin";
+    BinarySerializer::Write(YAML::Load(yaml), tempPath);
+    auto document = FlatDocument::Map(tempPath);
+    fs::remove(tempPath);
+    return document;
+}
+
+/**
+ * Compare the nodes, ignoring the first character of the tags like the factories do
+ */
+static void ExpectSameNode(const FlatDocument& expected, std::uint32_t expectedNode, const FlatDocument& actual, std::uint32_t actualNode, const std::string& path) {
+    const auto& expectedFlatNode = expected.GetNode(expectedNode);
+    const auto& actualFlatNode = actual.GetNode(actualNode);
+    auto stripTag = [](std::string_view tag) { return tag.empty() ? tag : tag.substr(1); };
+
+    ASSERT_EQ(expectedFlatNode.type, actualFlatNode.type) << path;
+    ASSERT_EQ(stripTag(expected.GetTag(expectedFlatNode)), stripTag(actual.GetTag(actualFlatNode))) << path;
+    ASSERT_EQ(expected.GetScalar(expectedFlatNode), actual.GetScalar(actualFlatNode)) << path;
+    ASSERT_EQ(expectedFlatNode.entryCount, actualFlatNode.entryCount) << path;
+
+    auto actualEntry = actual.BeginEntries(actualFlatNode);
+    for (auto expectedEntry = expected.BeginEntries(expectedFlatNode); expectedEntry != expected.EndEntries(expectedFlatNode); ++expectedEntry, ++actualEntry) {
+        auto key = std::string(expected.GetKey(*expectedEntry));
+        ASSERT_EQ(key, actual.GetKey(*actualEntry)) << path;
+        ExpectSameNode(expected, expectedEntry->node, actual, actualEntry->node, path + "/" + key);
+    }
+}
+
+class InSituYamlReaderTestFixture : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(InSituYamlReaderTestFixture, ShouldReadLikeYamlCpp) {
+    // arrange
+    const auto& yaml = GetParam();
+    auto expected = ReadWithYamlCpp(yaml);
+
+    // act
+    auto actual = InSituYamlReader::ReadString(yaml);
+
+    // assert
+    ExpectSameNode(*expected, expected->GetRoot(), *actual, actual->GetRoot(), "root");
+}
+
+INSTANTIATE_TEST_SUITE_P(InSituYamlReaderTests, InSituYamlReaderTestFixture,
+                         testing::Values("---\n item: \"im a string!\"",
+                                         "item: value\nint: 1\ndouble: 2.5 # comment\nempty:\nnothing: ~\nquoted: \"\"\n",
+                                         "# comment\n%YAML 1.2\n---\nlist:\n  - 1\n  - two\n  -\n  - - 3\n    - 4\nsameIndent:\n- a\n- b\nafter: c\n",
+                                         "items:\n  - !redClassType\n    subItem1: 1.0\n  - !blueClassType\n    subItem2: 2.0\n  - subItem3: 3.0\n    subItem4: 4.0\n",
+                                         "item: !tagged\n  child: !!str 22\n  other: !<verbatim> x\n  scalarTag: !tag value\n",
+                                         "flow: [1, 2.5, [a, b], {c: d, e: }, \"q, r\", 'it''s']\nmap: {x: 1, \"y\": [2,3]}\nmultiline: [1,\n  2, # comment\n  3]\n",
+                                         "double: \"tab\\tnew\\nline \\\"quoted\\\" \\u00e9 \\x41 \\\\\"\nsingle: 'don''t'\nfolded: \"first\n  second\n\n  third\"\n",
+                                         "literal: |\n  line 1\n   indented\n\n  line 3\nfolded: >\n  one\n  two\n\n  three\nstrip: |-\n  text\n\nkeep: |+\n  text\n\nnext: value\n",
+                                         "plain: this is\n  continued\n  over lines\nurl: http://example.com:80/path\nkey with spaces: value:with colon\n",
+                                         "root: &anchor\n  a: 1\nalias: *anchor\nlist:\n  - &scalar 2\n  - *scalar\n  - *anchor\n",
+                                         "\"quoted key\": 1\n'single key': 2\n",
+                                         "first: 1\n---\nsecond: 2\n",
+                                         "",
+                                         "just a scalar",
+                                         "- a\n- b: c\n  d: e\n-   f: g\n    h: i\n",
+                                         "a: 1\r\nb:\r\n  - x\r\n  - 'y'\r\n",
+                                         "items:\n\n  # comment\n  - a # trailing\n\n  - b\t\nnested:\n    deeper:\n        - !tag\n          x: 1\n"),
+                         [](const testing::TestParamInfo<std::string>& info) { return "document" + std::to_string(info.index); });
+
+TEST(InSituYamlReaderTests, ShouldShareAnchoredNodes) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "item1: &anchor1" << std::endl;
+    yaml << "  subItem1: 1.0" << std::endl;
+    yaml << "item2: *anchor1" << std::endl;
+
+    // act
+    auto document = InSituYamlReader::ReadString(yaml.str());
+
+    // assert
+    const auto& root = document->GetNode(document->GetRoot());
+    ASSERT_EQ(2, root.entryCount);
+    ASSERT_EQ(document->BeginEntries(root)[0].node, document->BeginEntries(root)[1].node);
+}
+
+TEST(InSituYamlReaderTests, ShouldReferenceTheSourceText) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "inSituYamlReaderInPlace.yaml";
+    std::ofstream ofs(tempPath);
+    ofs << "item: value" << std::endl;
+    ofs << "escaped: \"a\\tb\"" << std::endl;
+    ofs.close();
+
+    // act
+    auto document = InSituYamlReader::Read(tempPath);
+
+    // assert
+    const auto& root = document->GetNode(document->GetRoot());
+    const auto& item = document->GetNode(document->BeginEntries(root)[0].node);
+    const auto& escaped = document->GetNode(document->BeginEntries(root)[1].node);
+    ASSERT_EQ(0u, document->BeginEntries(root)[0].keyOffset);
+    ASSERT_EQ(6u, item.scalarOffset);
+    ASSERT_EQ("value", document->GetScalar(item));
+    ASSERT_TRUE(escaped.scalarOffset & arenaOffsetFlag);
+    ASSERT_EQ("a\tb", document->GetScalar(escaped));
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+TEST(InSituYamlReaderTests, ShouldReportUnsupportedOrInvalidDocuments) {
+    // arrange
+    // act
+    // assert
+    ASSERT_THROW(InSituYamlReader::ReadString("item: *missing\n"), std::invalid_argument);
+    ASSERT_THROW(InSituYamlReader::ReadString("item: \"unterminated\n"), std::invalid_argument);
+    ASSERT_THROW(InSituYamlReader::ReadString("item: [1, 2\n"), std::invalid_argument);
+    ASSERT_THROW(InSituYamlReader::ReadString("item: a: b\n"), std::invalid_argument);
+    ASSERT_THROW(InSituYamlReader::ReadString("? complex\n: key\n"), std::invalid_argument);
+    ASSERT_THROW(InSituYamlReader::ReadString("item:\n  a: 1\n    b: 2\n"), std::invalid_argument);
+}
+
+TEST(InSituYamlReaderTests, ShouldCreateMappedFactoryFromYamlFile) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "inSituYamlReaderFactory.yaml";
+    std::ofstream ofs(tempPath);
+    ofs << "---" << std::endl;
+    ofs << " item: !redClassType" << std::endl;
+    ofs << "   subItem1: 1.0" << std::endl;
+    ofs << "   subItem2: [1, 2]" << std::endl;
+    ofs << " unused: \"im a string!\"" << std::endl;
+    ofs.close();
+
+    // act
+    auto mappedFactory = std::make_shared<MappedFactory>(tempPath, MappedFileFormat::Yaml);
+    auto itemFactory = mappedFactory->GetFactory("item");
+
+    // assert
+    ASSERT_EQ("redClassType", itemFactory->GetClassType());
+    ASSERT_EQ(1.0, itemFactory->Get(ArgumentIdentifier<double>{"subItem1"}));
+    ASSERT_EQ((std::vector<int>{1, 2}), itemFactory->Get(ArgumentIdentifier<std::vector<int>>{"subItem2"}));
+    ASSERT_EQ((std::vector<std::string>{"root/unused"}), mappedFactory->GetUnusedValues());
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+}  // namespace cppParserTesting
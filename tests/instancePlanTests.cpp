@@ -0,0 +1,130 @@
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "instancePlan.hpp"
+#include "registrar.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+class PlanMockInterface {
+   public:
+    virtual ~PlanMockInterface() = default;
+};
+
+class PlanMockLeaf : public PlanMockInterface {
+   public:
+    inline static std::atomic<int> count = 0;
+    const int value;
+
+    explicit PlanMockLeaf(int value) : value(value) { count++; }
+};
+
+class PlanMockParent : public PlanMockInterface {
+   public:
+    const std::shared_ptr<PlanMockInterface> child;
+    const std::vector<std::shared_ptr<PlanMockInterface>> list;
+    const std::map<std::string, std::shared_ptr<PlanMockInterface>> map;
+
+    PlanMockParent(std::shared_ptr<PlanMockInterface> child, std::vector<std::shared_ptr<PlanMockInterface>> list, std::map<std::string, std::shared_ptr<PlanMockInterface>> map)
+        : child(std::move(child)), list(std::move(list)), map(std::move(map)) {}
+};
+
+static void RegisterPlanMockClasses() {
+    Registrar<PlanMockInterface>::Register<PlanMockLeaf>(false, "PlanMockLeaf", "a leaf", ArgumentIdentifier<int>{.inputName = "value"});
+    Registrar<PlanMockInterface>::Register<PlanMockParent>(false,
+                                                           "PlanMockParent",
+                                                           "a parent",
+                                                           ArgumentIdentifier<PlanMockInterface>{.inputName = "child"},
+                                                           ArgumentIdentifier<std::vector<PlanMockInterface>>{.inputName = "list"},
+                                                           ArgumentIdentifier<std::map<std::string, PlanMockInterface>>{.inputName = "map", .optional = true});
+}
+
+static std::string PlanMockDocument() {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "components:" << std::endl;
+    for (int i = 0; i < 10; i++) {
+        yaml << "  - !PlanMockParent" << std::endl;
+        yaml << "    child: !PlanMockLeaf" << std::endl;
+        yaml << "      value: " << i << std::endl;
+        yaml << "    list:" << std::endl;
+        yaml << "      - !PlanMockLeaf" << std::endl;
+        yaml << "        value: " << 10 * i << std::endl;
+        yaml << "      - !PlanMockParent" << std::endl;
+        yaml << "        child: !PlanMockLeaf" << std::endl;
+        yaml << "          value: " << 100 * i << std::endl;
+        yaml << "        list: []" << std::endl;
+        if (i == 0) {
+            yaml << "    map:" << std::endl;
+            yaml << "      shared: &shared !PlanMockLeaf" << std::endl;
+            yaml << "        value: -1" << std::endl;
+        } else {
+            yaml << "    map:" << std::endl;
+            yaml << "      shared: *shared" << std::endl;
+        }
+    }
+    return yaml.str();
+}
+
+TEST(InstancePlanTests, ShouldPlanEachInstanceOnce) {
+    // arrange
+    RegisterPlanMockClasses();
+    auto yamlParser = std::make_shared<YamlParser>(PlanMockDocument());
+
+    // act
+    InstancePlan plan;
+    plan.AddArgument(yamlParser, std::nullopt, ArgumentIdentifier<std::vector<PlanMockInterface>>{.inputName = "components"});
+
+    // assert
+    // each component has two parents and three leaves, and the anchored leaf is shared by every component
+    ASSERT_EQ(10 * 5 + 1, plan.Size());
+}
+
+TEST(InstancePlanTests, ShouldCreateInstancesFromPlan) {
+    // arrange
+    RegisterPlanMockClasses();
+    auto yamlParser = std::make_shared<YamlParser>(PlanMockDocument(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.parallel = true});
+    PlanMockLeaf::count = 0;
+
+    // act
+    auto components = InstancePlan::Get(yamlParser, ArgumentIdentifier<std::vector<PlanMockInterface>>{.inputName = "components"});
+
+    // assert
+    ASSERT_EQ(10 * 3 + 1, PlanMockLeaf::count);
+    ASSERT_EQ(10, components.size());
+    std::shared_ptr<PlanMockInterface> shared;
+    for (int i = 0; i < 10; i++) {
+        auto parent = std::dynamic_pointer_cast<PlanMockParent>(components[i]);
+        ASSERT_TRUE(parent);
+        ASSERT_EQ(i, std::dynamic_pointer_cast<PlanMockLeaf>(parent->child)->value);
+        ASSERT_EQ(10 * i, std::dynamic_pointer_cast<PlanMockLeaf>(parent->list[0])->value);
+        ASSERT_EQ(100 * i, std::dynamic_pointer_cast<PlanMockLeaf>(std::dynamic_pointer_cast<PlanMockParent>(parent->list[1])->child)->value);
+
+        // the anchored leaf must be the same instance
+        shared = shared ? shared : parent->map.at("shared");
+        ASSERT_EQ(shared, parent->map.at("shared"));
+    }
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
+TEST(InstancePlanTests, ShouldReportErrorsFromPlannedInstances) {
+    // arrange
+    RegisterPlanMockClasses();
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "component: !PlanMockParent" << std::endl;
+    yaml << "  child: !UnknownPlanMockClass" << std::endl;
+    yaml << "    value: 1" << std::endl;
+    yaml << "  list: []" << std::endl;
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.parallel = true});
+
+    // act
+    // assert
+    ASSERT_THROW(InstancePlan::Get(yamlParser, ArgumentIdentifier<PlanMockInterface>{.inputName = "component"}), std::invalid_argument);
+}
+
+}  // namespace cppParserTesting
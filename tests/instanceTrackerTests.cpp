@@ -0,0 +1,319 @@
+#include <chrono>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "instanceTracker.hpp"
+#include "registrar.hpp"
+#include "workStealingExecutor.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+class InstanceTrackerMockInterface {
+   public:
+    virtual ~InstanceTrackerMockInterface() = default;
+};
+
+class InstanceTrackerMockClass : public InstanceTrackerMockInterface {
+   public:
+    const int value;
+
+    explicit InstanceTrackerMockClass(int value) : value(value) {}
+};
+
+class InstanceTrackerHotMockClass : public InstanceTrackerMockInterface {
+   public:
+    const int value;
+
+    explicit InstanceTrackerHotMockClass(int value) : value(value) {}
+};
+
+class InstanceTrackerSlowMockClass : public InstanceTrackerMockInterface {
+   public:
+    explicit InstanceTrackerSlowMockClass(int value) { std::this_thread::sleep_for(std::chrono::microseconds(value)); }
+};
+
+class InstanceTrackerListMockClass : public InstanceTrackerMockInterface {
+   public:
+    const std::vector<std::shared_ptr<InstanceTrackerMockInterface>> children;
+
+    explicit InstanceTrackerListMockClass(std::vector<std::shared_ptr<InstanceTrackerMockInterface>> children) : children(std::move(children)) {}
+};
+
+static std::shared_ptr<YamlParser> CreateInstanceTrackerParser(const InstanceTrackerOptions& trackerOptions = {}) {
+    cppParser::Registrar<InstanceTrackerMockInterface>::Register<InstanceTrackerMockClass>(false, "InstanceTrackerMockClass", "this is a simple mock class",
+                                                                                         ArgumentIdentifier<int>{.inputName = "value"});
+    cppParser::Registrar<InstanceTrackerMockInterface>::Register<InstanceTrackerHotMockClass>(false, "InstanceTrackerHotMockClass", "this is a hot mock class",
+                                                                                            ArgumentIdentifier<int>{.inputName = "value"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "shared: !InstanceTrackerMockClass" << std::endl;
+    yaml << "  value: 1" << std::endl;
+    yaml << "hot: !InstanceTrackerHotMockClass" << std::endl;
+    yaml << "  value: 2" << std::endl;
+    return std::make_shared<YamlParser>(yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.instanceTracker = trackerOptions});
+}
+
+TEST(InstanceTrackerTests, ShouldCreateAliasesInParallelSequencesOnce) {
+    // arrange
+    cppParser::Registrar<InstanceTrackerMockInterface>::Register<InstanceTrackerSlowMockClass>(false, "InstanceTrackerSlowMockClass", "this is a slow mock class",
+                                                                                             ArgumentIdentifier<int>{.inputName = "value"});
+    cppParser::Registrar<InstanceTrackerMockInterface>::Register<InstanceTrackerListMockClass>(
+        false, "InstanceTrackerListMockClass", "this is a list mock class", ArgumentIdentifier<std::vector<InstanceTrackerMockInterface>>{.inputName = "children"});
+
+    // the aliased list is reached both directly and from the children of its siblings while its own children are still being created in parallel
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "shared: &shared !InstanceTrackerListMockClass" << std::endl;
+    yaml << "  children:" << std::endl;
+    for (int i = 0; i < 16; i++) {
+        yaml << "    - !InstanceTrackerSlowMockClass {value: " << 100 + i << "}" << std::endl;
+    }
+    yaml << "list:" << std::endl;
+    for (int i = 0; i < 32; i++) {
+        if (i % 4 == 0) {
+            yaml << "  - *shared" << std::endl;
+        } else {
+            yaml << "  - !InstanceTrackerListMockClass" << std::endl;
+            yaml << "    children:" << std::endl;
+            yaml << "      - *shared" << std::endl;
+            yaml << "      - !InstanceTrackerSlowMockClass {value: " << i << "}" << std::endl;
+        }
+    }
+
+    for (int repeat = 0; repeat < 10; repeat++) {
+        auto yamlParser = std::make_shared<YamlParser>(yaml.str(),
+                                                       std::vector<std::filesystem::path>{},
+                                                       std::map<std::string, std::string>{},
+                                                       YamlParserOptions{.parallel = true, .executor = std::make_shared<WorkStealingExecutor>(4)});
+
+        // act
+        auto list = yamlParser->GetByName<std::vector<InstanceTrackerMockInterface>>("list");
+
+        // assert
+        auto shared = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+        ASSERT_EQ(32, list.size());
+        for (std::size_t i = 0; i < list.size(); i++) {
+            if (i % 4 == 0) {
+                ASSERT_EQ(shared, list[i]);
+            } else {
+                ASSERT_EQ(shared, std::dynamic_pointer_cast<InstanceTrackerListMockClass>(list[i])->children.front());
+            }
+        }
+    }
+}
+
+TEST(InstanceTrackerTests, ShouldKeepThreadScopesOutOfParallelCreates) {
+    // arrange
+    CreateInstanceTrackerParser();
+    cppParser::Registrar<InstanceTrackerMockInterface>::Register<InstanceTrackerSlowMockClass>(false, "InstanceTrackerSlowMockClass", "this is a slow mock class",
+                                                                                             ArgumentIdentifier<int>{.inputName = "value"});
+
+    // the slow elements keep the executor threads busy with the list of the scoped thread
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "hot: &hot !InstanceTrackerHotMockClass {value: 2}" << std::endl;
+    yaml << "list:" << std::endl;
+    for (int i = 0; i < 32; i++) {
+        if (i % 2 == 0) {
+            yaml << "  - *hot" << std::endl;
+        } else {
+            yaml << "  - !InstanceTrackerSlowMockClass {value: " << 200 + i << "}" << std::endl;
+        }
+    }
+    auto yamlParser = std::make_shared<YamlParser>(
+        yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.parallel = true, .executor = std::make_shared<WorkStealingExecutor>(4)});
+
+    // act
+    std::vector<std::shared_ptr<InstanceTrackerMockInterface>> scopedList;
+    std::vector<std::shared_ptr<InstanceTrackerMockInterface>> sharedList;
+    std::shared_ptr<InstanceTrackerMockInterface> scopedHot;
+    std::size_t scopeSize = 0;
+    std::thread scopedThread([&] {
+        InstanceTracker::ThreadScope scope(*yamlParser->GetInstanceTracker(), {"InstanceTrackerHotMockClass"});
+        scopedList = yamlParser->GetByName<std::vector<InstanceTrackerMockInterface>>("list");
+        scopedHot = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+        scopeSize = scope.Size();
+    });
+    std::thread sharedThread([&] { sharedList = yamlParser->GetByName<std::vector<InstanceTrackerMockInterface>>("list"); });
+    scopedThread.join();
+    sharedThread.join();
+    auto sharedHot = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+
+    // assert
+    ASSERT_EQ(1, scopeSize);
+    ASSERT_NE(sharedHot, scopedHot);
+    ASSERT_EQ(32, scopedList.size());
+    ASSERT_EQ(32, sharedList.size());
+    for (std::size_t i = 0; i < scopedList.size(); i += 2) {
+        ASSERT_EQ(scopedHot, scopedList[i]);
+        ASSERT_EQ(sharedHot, sharedList[i]);
+    }
+}
+
+TEST(InstanceTrackerTests, ShouldShareInstancesBetweenThreadsWithoutScope) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser();
+    std::vector<std::shared_ptr<InstanceTrackerMockInterface>> instances(8);
+
+    // act
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < instances.size(); i++) {
+        threads.emplace_back([&yamlParser, &instances, i] { instances[i] = yamlParser->GetByName<InstanceTrackerMockInterface>("shared"); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // assert
+    for (const auto& instance : instances) {
+        ASSERT_TRUE(instance);
+        ASSERT_EQ(instances.front(), instance);
+    }
+}
+
+TEST(InstanceTrackerTests, ShouldCreateOneInstancePerThreadScope) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser();
+    auto tracker = yamlParser->GetInstanceTracker();
+    ASSERT_TRUE(tracker);
+    std::vector<std::shared_ptr<InstanceTrackerMockInterface>> firstInstances(4);
+    std::vector<std::shared_ptr<InstanceTrackerMockInterface>> secondInstances(4);
+    std::vector<std::size_t> scopeSizes(4);
+
+    // act
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < firstInstances.size(); i++) {
+        threads.emplace_back([&, i] {
+            InstanceTracker::ThreadScope scope(*tracker);
+            firstInstances[i] = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+            secondInstances[i] = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+            scopeSizes[i] = scope.Size();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto sharedInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+
+    // assert
+    for (std::size_t i = 0; i < firstInstances.size(); i++) {
+        ASSERT_EQ(firstInstances[i], secondInstances[i]);
+        ASSERT_EQ(1, scopeSizes[i]);
+        ASSERT_NE(sharedInstance, firstInstances[i]);
+        for (std::size_t j = 0; j < i; j++) {
+            ASSERT_NE(firstInstances[j], firstInstances[i]);
+        }
+    }
+    ASSERT_EQ(sharedInstance, yamlParser->GetByName<InstanceTrackerMockInterface>("hot"));
+}
+
+TEST(InstanceTrackerTests, ShouldOnlyScopeListedClassTypes) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser();
+    auto sharedInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+    auto hotInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+
+    // act
+    std::shared_ptr<InstanceTrackerMockInterface> scopedSharedInstance;
+    std::shared_ptr<InstanceTrackerMockInterface> scopedHotInstance;
+    {
+        InstanceTracker::ThreadScope scope(*yamlParser->GetInstanceTracker(), {"InstanceTrackerHotMockClass"});
+        scopedSharedInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+        scopedHotInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+    }
+
+    // assert
+    ASSERT_EQ(sharedInstance, scopedSharedInstance);
+    ASSERT_NE(hotInstance, scopedHotInstance);
+    ASSERT_EQ(2, std::dynamic_pointer_cast<InstanceTrackerHotMockClass>(scopedHotInstance)->value);
+    ASSERT_EQ(hotInstance, yamlParser->GetByName<InstanceTrackerMockInterface>("hot"));
+}
+
+TEST(InstanceTrackerTests, ShouldKeepStrongInstancesForTheLifeOfTheTracker) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser();
+    std::weak_ptr<InstanceTrackerMockInterface> released = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+
+    // act
+    auto instance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+
+    // assert
+    ASSERT_EQ(released.lock(), instance);
+    auto statistics = yamlParser->GetInstanceTracker()->GetStatistics();
+    ASSERT_EQ(1, statistics.hits);
+    ASSERT_EQ(1, statistics.misses);
+    ASSERT_EQ(0, statistics.evictions);
+    ASSERT_EQ(0, statistics.expired);
+}
+
+TEST(InstanceTrackerTests, ShouldCountMissesFromLookups) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser();
+    auto tracker = yamlParser->GetInstanceTracker();
+    auto factory = yamlParser->GetFactory("shared");
+
+    // act
+    auto missing = tracker->GetInstance<InstanceTrackerMockInterface>(factory);
+    auto created = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+    auto found = tracker->GetInstance<InstanceTrackerMockInterface>(factory);
+
+    // assert
+    ASSERT_FALSE(missing);
+    ASSERT_EQ(created, found);
+    auto statistics = tracker->GetStatistics();
+    ASSERT_EQ(1, statistics.hits);
+    ASSERT_EQ(2, statistics.misses);
+}
+
+TEST(InstanceTrackerTests, ShouldReleaseWeakInstancesWhenUnused) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser({.retention = InstanceRetention::Weak});
+
+    // act
+    auto instance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+    auto sameInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+    std::weak_ptr<InstanceTrackerMockInterface> released = instance;
+    instance.reset();
+    sameInstance.reset();
+    auto recreatedInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+
+    // assert
+    ASSERT_TRUE(released.expired());
+    ASSERT_TRUE(recreatedInstance);
+    ASSERT_EQ(1, std::dynamic_pointer_cast<InstanceTrackerMockClass>(recreatedInstance)->value);
+    ASSERT_EQ(recreatedInstance, yamlParser->GetByName<InstanceTrackerMockInterface>("shared"));
+    auto statistics = yamlParser->GetInstanceTracker()->GetStatistics();
+    ASSERT_EQ(2, statistics.hits);
+    ASSERT_EQ(2, statistics.misses);
+    ASSERT_EQ(0, statistics.evictions);
+    ASSERT_EQ(1, statistics.expired);
+}
+
+TEST(InstanceTrackerTests, ShouldPinMostRecentlyUsedWeakInstances) {
+    // arrange
+    auto yamlParser = CreateInstanceTrackerParser({.retention = InstanceRetention::Weak, .pinnedCapacity = 1});
+
+    // act
+    std::weak_ptr<InstanceTrackerMockInterface> sharedInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("shared");
+    auto pinnedWhileMostRecent = !sharedInstance.expired();
+    std::weak_ptr<InstanceTrackerMockInterface> hotInstance = yamlParser->GetByName<InstanceTrackerMockInterface>("hot");
+
+    // assert
+    ASSERT_TRUE(pinnedWhileMostRecent);
+    ASSERT_TRUE(sharedInstance.expired());
+    ASSERT_FALSE(hotInstance.expired());
+    ASSERT_EQ(hotInstance.lock(), yamlParser->GetByName<InstanceTrackerMockInterface>("hot"));
+    auto statistics = yamlParser->GetInstanceTracker()->GetStatistics();
+    ASSERT_EQ(1, statistics.hits);
+    ASSERT_EQ(2, statistics.misses);
+    ASSERT_EQ(1, statistics.evictions);
+}
+
+}  // namespace cppParserTesting
@@ -0,0 +1,263 @@
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include "binarySerializer.hpp"
+#include "gtest/gtest.h"
+#include "inSituYamlReader.hpp"
+#include "mappedFactory.hpp"
+#include "registrar.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+namespace fs = std::filesystem;
+
+/**
+ * Write the yaml string to a binary file and map it
+ */
+static std::shared_ptr<MappedFactory> CreateMappedFactory(const std::string& yaml, const fs::path& binaryPath) {
+    BinarySerializer::Write(YAML::Load(yaml), binaryPath);
+    return std::make_shared<MappedFactory>(binaryPath);
+}
+
+TEST(MappedFactoryTests, ShouldGetValuesLikeYamlParser) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryValues.bin";
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " int: 22" << std::endl;
+    yaml << " double: 3.5" << std::endl;
+    yaml << " bool: true" << std::endl;
+    yaml << " string: \"im a string \"" << std::endl;
+    yaml << " ints: [1, 2, 3]" << std::endl;
+    yaml << " doubles: [1.5, 2.5]" << std::endl;
+    yaml << " strings: [a, b]" << std::endl;
+    yaml << " intsList: [[1, 2], [3]]" << std::endl;
+    yaml << " map:" << std::endl;
+    yaml << "   key1: value1" << std::endl;
+    yaml << "   key2: value2" << std::endl;
+    yaml << " empty: ~" << std::endl;
+
+    // act
+    auto mappedFactory = CreateMappedFactory(yaml.str(), tempPath);
+
+    // assert
+    ASSERT_EQ(22, mappedFactory->Get(ArgumentIdentifier<int>{"int"}));
+    ASSERT_EQ(3.5, mappedFactory->Get(ArgumentIdentifier<double>{"double"}));
+    ASSERT_TRUE(mappedFactory->Get(ArgumentIdentifier<bool>{"bool"}));
+    ASSERT_EQ("im a string ", mappedFactory->Get(ArgumentIdentifier<std::string>{"string"}));
+    ASSERT_EQ("1 2 3 ", mappedFactory->Get(ArgumentIdentifier<std::string>{"ints"}));
+    ASSERT_EQ((std::vector<int>{1, 2, 3}), mappedFactory->Get(ArgumentIdentifier<std::vector<int>>{"ints"}));
+    ASSERT_EQ((std::vector<double>{1.5, 2.5}), mappedFactory->Get(ArgumentIdentifier<std::vector<double>>{"doubles"}));
+    ASSERT_EQ((std::vector<std::string>{"a", "b"}), mappedFactory->Get(ArgumentIdentifier<std::vector<std::string>>{"strings"}));
+    ASSERT_EQ((std::vector<std::vector<int>>{{1, 2}, {3}}), mappedFactory->Get(ArgumentIdentifier<std::vector<std::vector<int>>>{"intsList"}));
+    ASSERT_EQ((std::map<std::string, std::string>{{"key1", "value1"}, {"key2", "value2"}}), mappedFactory->Get(ArgumentIdentifier<std::map<std::string, std::string>>{"map"}));
+    ASSERT_EQ(0, mappedFactory->Get(ArgumentIdentifier<int>{.inputName = "missing", .optional = true}));
+    ASSERT_THROW(mappedFactory->Get(ArgumentIdentifier<int>{"missing"}), std::invalid_argument);
+    ASSERT_THROW(mappedFactory->Get(ArgumentIdentifier<int>{"string"}), YAML::BadConversion);
+
+    ASSERT_TRUE(mappedFactory->Contains("int"));
+    ASSERT_FALSE(mappedFactory->Contains("empty"));
+    ASSERT_FALSE(mappedFactory->Contains("missing"));
+    ASSERT_EQ((std::unordered_set<std::string>{"int", "double", "bool", "string", "ints", "doubles", "strings", "intsList", "map", "empty"}), mappedFactory->GetKeys());
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+/**
+ * The message thrown by the get, or empty if nothing is thrown
+ */
+template <typename T>
+static std::string GetErrorMessage(const Factory& factory, const std::string& name) {
+    try {
+        factory.Get(ArgumentIdentifier<T>{name});
+    } catch (const YAML::BadConversion& exception) {
+        return exception.what();
+    }
+    return {};
+}
+
+TEST(MappedFactoryTests, ShouldReportConversionErrorsLikeYamlParser) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryErrors.bin";
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "string: im a string" << std::endl;
+    yaml << "ints: [1, two, 3]" << std::endl;
+    yaml << "intsList:" << std::endl;
+    yaml << "  - [1, 2]" << std::endl;
+    yaml << "  - [3, !tagged four]" << std::endl;
+    yaml << "map:" << std::endl;
+    yaml << "  key1: value1" << std::endl;
+    yaml << "  key2: [a, b]" << std::endl;
+    yaml << "nested:" << std::endl;
+    yaml << "  a: 1" << std::endl;
+    yaml << "block: |" << std::endl;
+    yaml << "  line" << std::endl;
+
+    YamlParser yamlParser(yaml.str());
+    using StringMap = std::map<std::string, std::string>;
+
+    // act
+    auto binaryFactory = CreateMappedFactory(yaml.str(), tempPath);
+    MappedFactory inSituFactory(InSituYamlReader::ReadString(yaml.str()));
+
+    // assert
+    ASSERT_EQ("yaml-cpp: error at line 2, column 9: bad conversion", GetErrorMessage<int>(yamlParser, "string"));
+    for (const Factory* factory : std::vector<const Factory*>{binaryFactory.get(), &inSituFactory}) {
+        ASSERT_EQ(GetErrorMessage<int>(yamlParser, "string"), GetErrorMessage<int>(*factory, "string"));
+        ASSERT_EQ(GetErrorMessage<std::vector<int>>(yamlParser, "ints"), GetErrorMessage<std::vector<int>>(*factory, "ints"));
+        ASSERT_EQ(GetErrorMessage<std::vector<std::vector<int>>>(yamlParser, "intsList"), GetErrorMessage<std::vector<std::vector<int>>>(*factory, "intsList"));
+        ASSERT_EQ(GetErrorMessage<StringMap>(yamlParser, "map"), GetErrorMessage<StringMap>(*factory, "map"));
+        ASSERT_EQ(GetErrorMessage<std::string>(yamlParser, "nested"), GetErrorMessage<std::string>(*factory, "nested"));
+        ASSERT_EQ(GetErrorMessage<double>(yamlParser, "block"), GetErrorMessage<double>(*factory, "block"));
+    }
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+TEST(MappedFactoryTests, ShouldGetTaggedFactoriesAndUnusedValues) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryFactories.bin";
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " item: !redClassType" << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << "   subItem2: 2.0" << std::endl;
+    yaml << " list:" << std::endl;
+    yaml << "   - subItem1: 1.0" << std::endl;
+    yaml << "   - !blueClassType" << std::endl;
+    yaml << "     subItem2: 2.0" << std::endl;
+    yaml << " unused: 3" << std::endl;
+
+    auto mappedFactory = CreateMappedFactory(yaml.str(), tempPath);
+
+    // act
+    auto itemFactory = mappedFactory->GetFactory("item");
+    auto listFactories = mappedFactory->GetFactorySequence("list");
+
+    // assert
+    ASSERT_EQ("redClassType", itemFactory->GetClassType());
+    ASSERT_EQ(1.0, itemFactory->Get(ArgumentIdentifier<double>{"subItem1"}));
+    ASSERT_EQ(itemFactory, mappedFactory->GetFactory("item"));
+    ASSERT_EQ(2, listFactories.size());
+    ASSERT_EQ("", listFactories[0]->GetClassType());
+    ASSERT_EQ(1.0, listFactories[0]->Get(ArgumentIdentifier<double>{"subItem1"}));
+    ASSERT_EQ("blueClassType", listFactories[1]->GetClassType());
+    ASSERT_THROW(mappedFactory->GetFactory("missing"), std::invalid_argument);
+    ASSERT_THROW(mappedFactory->GetFactorySequence("item"), std::invalid_argument);
+
+    ASSERT_EQ((std::vector<std::string>{"root/unused", "root/item/subItem2", "root/list/1/subItem2"}), mappedFactory->GetUnusedValues());
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+class MappedMockClass {};
+
+TEST(MappedFactoryTests, ShouldReuseInstancesForAnchors) {
+    // arrange
+    cppParser::Registrar<MappedMockClass>::Register<MappedMockClass>(true, std::string("MappedMockClass"), "this is a simple mock class");
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryAnchors.bin";
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " item1: " << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << " item2: &anchor1" << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << " item3: *anchor1" << std::endl;
+    yaml << " itemList:" << std::endl;
+    yaml << "   - *anchor1" << std::endl;
+
+    auto mappedFactory = CreateMappedFactory(yaml.str(), tempPath);
+
+    // act
+    auto instance1 = mappedFactory->GetByName<MappedMockClass>("item1");
+    auto instance2 = mappedFactory->GetByName<MappedMockClass>("item2");
+    auto instance3 = mappedFactory->GetByName<MappedMockClass>("item3");
+    auto itemList = mappedFactory->GetByName<std::vector<MappedMockClass>>("itemList");
+
+    // assert
+    ASSERT_TRUE(instance1);
+    ASSERT_NE(instance1, instance2);
+    ASSERT_EQ(instance2, instance3);
+    ASSERT_EQ(instance2, itemList[0]);
+    ASSERT_TRUE(*mappedFactory->GetFactory("item2") == *mappedFactory->GetFactory("item3"));
+    ASSERT_FALSE(*mappedFactory->GetFactory("item1") == *mappedFactory->GetFactory("item2"));
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+TEST(MappedFactoryTests, ShouldGetFactoryEntriesInDocumentOrder) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryEntries.bin";
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " zeta: {value: 1}" << std::endl;
+    yaml << " alpha: {value: 2}" << std::endl;
+    yaml << " mid: {value: 3}" << std::endl;
+
+    auto mappedFactory = CreateMappedFactory(yaml.str(), tempPath);
+
+    // act
+    auto entries = mappedFactory->GetFactoryEntries();
+
+    // assert
+    ASSERT_EQ(3, entries.size());
+    std::vector<std::string> keys;
+    for (const auto& [key, childFactory] : entries) {
+        keys.push_back(key);
+        ASSERT_EQ(mappedFactory->GetFactory(key), childFactory);
+    }
+    ASSERT_EQ((std::vector<std::string>{"zeta", "alpha", "mid"}), keys);
+    ASSERT_EQ(2, entries[1].second->GetByName<int>("value"));
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+TEST(MappedFactoryTests, ShouldWriteBinaryFromYamlParser) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryOverwrite.bin";
+    auto yamlParser = std::make_shared<YamlParser>(std::string("---\n item: 1\n"), std::vector<fs::path>{}, std::map<std::string, std::string>{{"item", "2"}});
+
+    // act
+    {
+        std::ofstream binaryFile(tempPath, std::ios::binary);
+        yamlParser->WriteBinary(binaryFile);
+    }
+    auto mappedFactory = std::make_shared<MappedFactory>(tempPath);
+
+    // assert
+    ASSERT_EQ(2, mappedFactory->Get(ArgumentIdentifier<int>{"item"}));
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+TEST(MappedFactoryTests, ShouldThrowForInvalidBinaryFile) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "mappedFactoryInvalid.bin";
+    std::ofstream ofs(tempPath, std::ios::binary);
+    ofs << "---" << std::endl;
+    ofs << " item: \"im a yaml file\"";
+    ofs.close();
+
+    // act
+    // assert
+    ASSERT_THROW(std::make_shared<MappedFactory>(tempPath), std::invalid_argument);
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+}  // namespace cppParserTesting
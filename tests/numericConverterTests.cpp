@@ -0,0 +1,90 @@
+#include <cstring>
+#include <memory>
+#include "gtest/gtest.h"
+#include "numericConverter.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+/**
+ * Compare the bits so that nan and signed zeros are checked as well
+ */
+template <typename T>
+static void ExpectSameBits(const T& expected, const T& actual, const std::string& scalar) {
+    ASSERT_EQ(0, std::memcmp(&expected, &actual, sizeof(T))) << scalar << " expected " << expected << " but was " << actual;
+}
+
+/**
+ * Convert the scalar with yaml-cpp and the NumericConverter, either both throw or both give the same bits
+ */
+template <typename T>
+static void ExpectSameConversion(const std::string& scalar) {
+    YAML::Node node(scalar);
+
+    T expected{};
+    bool expectedThrows = false;
+    try {
+        expected = node.as<T>();
+    } catch (YAML::BadConversion&) {
+        expectedThrows = true;
+    }
+
+    if (expectedThrows) {
+        ASSERT_THROW(NumericConverter::Convert<T>(node), YAML::BadConversion) << scalar;
+    } else {
+        ExpectSameBits(expected, NumericConverter::Convert<T>(node), scalar);
+    }
+}
+
+class NumericConverterTestFixture : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(NumericConverterTestFixture, ShouldConvertIntsLikeYamlCpp) {
+    // arrange
+    // act
+    // assert
+    ExpectSameConversion<int>(GetParam());
+}
+
+TEST_P(NumericConverterTestFixture, ShouldConvertDoublesLikeYamlCpp) {
+    // arrange
+    // act
+    // assert
+    ExpectSameConversion<double>(GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(NumericConverterTests, NumericConverterTestFixture,
+                         testing::Values("0", "-0", "1", "-1", "22", "+22", "010", "0x1F", "-0x1F", "2147483647", "-2147483648", "2147483648", "99999999999999999999", "1.5", "-1.5",
+                                         ".5", "-.5", "5.", "1e5", "1E-5", "-2.5e+10", "1e400", "-1e400", "1e-400", "4.9406564584124654e-324", "0.1", "0.30000000000000004",
+                                         "3.14159265358979323846264338327950288", "123456789012345678901234567890", "1.7976931348623157e308", ".inf", "-.Inf", ".nan", "inf",
+                                         "nan", "1e", "1.5.3", "1_000", " 1", "1 ", "", "-", ".", "abc", "true", "0b101"),
+                         [](const testing::TestParamInfo<std::string>& info) { return "scalar" + std::to_string(info.index); });
+
+TEST(NumericConverterTests, ShouldConvertSequencesLikeYamlCpp) {
+    // arrange
+    auto yaml = YAML::Load("{doubles: [1.5, -2e3, .25, .inf], ints: [1, -2, 3], nested: [[1.5, 2], [], [3]], mixed: [1, 0x10], bad: [1, two], scalar: 1}");
+
+    // act
+    // assert
+    ASSERT_EQ(yaml["doubles"].as<std::vector<double>>(), NumericConverter::Convert<std::vector<double>>(yaml["doubles"]));
+    ASSERT_EQ(yaml["ints"].as<std::vector<int>>(), NumericConverter::Convert<std::vector<int>>(yaml["ints"]));
+    ASSERT_EQ(yaml["nested"].as<std::vector<std::vector<double>>>(), NumericConverter::Convert<std::vector<std::vector<double>>>(yaml["nested"]));
+    ASSERT_EQ((std::vector<int>{1, 16}), NumericConverter::Convert<std::vector<int>>(yaml["mixed"]));
+    ASSERT_THROW(NumericConverter::Convert<std::vector<int>>(yaml["bad"]), YAML::BadConversion);
+    ASSERT_THROW(NumericConverter::Convert<std::vector<int>>(yaml["scalar"]), YAML::BadConversion);
+}
+
+TEST(NumericConverterTests, ShouldGetNumbersFromYamlParser) {
+    // arrange
+    auto yamlParser = std::make_shared<YamlParser>(std::string("{int: 0x10, double: 2.5e-3, doubles: [1, 2.5, -.5], table: [[1, 2], [3, 4]]}"));
+
+    // act
+    // assert
+    ASSERT_EQ(16, yamlParser->Get(ArgumentIdentifier<int>{"int"}));
+    ASSERT_EQ(2.5e-3, yamlParser->Get(ArgumentIdentifier<double>{"double"}));
+    ASSERT_EQ((std::vector<double>{1, 2.5, -.5}), yamlParser->Get(ArgumentIdentifier<std::vector<double>>{"doubles"}));
+    ASSERT_EQ((std::vector<std::vector<int>>{{1, 2}, {3, 4}}), yamlParser->Get(ArgumentIdentifier<std::vector<std::vector<int>>>{"table"}));
+}
+
+}  // namespace cppParserTesting
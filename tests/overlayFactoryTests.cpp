@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "overlayFactory.hpp"
+#include "registrar.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+static std::string OverlayTestDocument() {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "item1: 22" << std::endl;
+    yaml << "item2:" << std::endl;
+    yaml << "  item3: 3" << std::endl;
+    yaml << "  item4: [1]" << std::endl;
+    yaml << "  item5: " << std::endl;
+    yaml << "    item6: {} " << std::endl;
+    yaml << "item9: " << std::endl;
+    yaml << "  - list1: 1" << std::endl;
+    yaml << "  - list2:" << std::endl;
+    yaml << "    item10: 10" << std::endl;
+    yaml << "item11: {a: 1, b: 2}" << std::endl;
+    return yaml.str();
+}
+
+TEST(OverlayFactoryTests, ShouldMatchOverwrittenYamlParser) {
+    // arrange
+    auto params = std::map<std::string, std::string>{
+        {"item1", "44"},
+        {"item2::item4", "[3, 2]"},
+        {"item2::item5::item6::item7", "77"},
+        {"item9::[1]::item10", "100"},
+        {"item11", "{c: 3}"},
+        {"item11::d", "4"},
+        {"item12::item13", "13"},
+    };
+    auto base = std::make_shared<YamlParser>(OverlayTestDocument());
+    auto expected = std::make_shared<YamlParser>(OverlayTestDocument(), std::vector<std::filesystem::path>{}, params);
+
+    // act
+    auto overlay = std::make_shared<OverlayFactory>(base, params);
+
+    // assert
+    for (const auto& factory : std::vector<std::shared_ptr<Factory>>{expected, overlay}) {
+        ASSERT_EQ("44", factory->GetByName<std::string>("item1"));
+        ASSERT_EQ((std::vector<double>{3, 2}), factory->GetFactory("item2")->GetByName<std::vector<double>>("item4"));
+        ASSERT_EQ(3, factory->GetFactory("item2")->GetByName<int>("item3"));
+        ASSERT_EQ("77", factory->GetFactory("item2")->GetFactory("item5")->GetFactory("item6")->GetByName<std::string>("item7"));
+        ASSERT_EQ("100", factory->GetFactorySequence("item9")[1]->GetByName<std::string>("item10"));
+        ASSERT_EQ(1, factory->GetFactorySequence("item9")[0]->GetByName<int>("list1"));
+        ASSERT_EQ((std::unordered_set<std::string>{"c", "d"}), factory->GetFactory("item11")->GetKeys());
+        ASSERT_EQ(13, factory->GetFactory("item12")->GetByName<int>("item13"));
+        ASSERT_TRUE(factory->Contains("item12"));
+        ASSERT_FALSE(factory->Contains("item13"));
+    }
+
+    // the base is not changed
+    ASSERT_EQ(22, base->GetByName<int>("item1"));
+    ASSERT_EQ(10, base->GetFactorySequence("item9")[1]->GetByName<int>("item10"));
+}
+
+TEST(OverlayFactoryTests, ShouldReportUnusedValuesLikeOverwrittenYamlParser) {
+    // arrange
+    auto params = std::map<std::string, std::string>{
+        {"item1", "44"},
+        {"item2::item3", "33"},
+        {"item2::item7", "77"},
+        {"item9::[0]::list1", "11"},
+    };
+    auto base = std::make_shared<YamlParser>(OverlayTestDocument());
+    auto expected = std::make_shared<YamlParser>(OverlayTestDocument(), std::vector<std::filesystem::path>{}, params);
+    auto overlay = std::make_shared<OverlayFactory>(base, params);
+
+    // act
+    std::vector<std::vector<std::string>> unusedValues;
+    for (const auto& factory : std::vector<std::shared_ptr<Factory>>{expected, overlay}) {
+        factory->GetByName<int>("item1");
+        factory->GetFactory("item2")->GetByName<int>("item3");
+        factory->GetFactorySequence("item9")[0]->GetByName<int>("list1");
+        auto unused = factory->GetUnusedValues();
+        std::sort(unused.begin(), unused.end());
+        unusedValues.push_back(unused);
+    }
+
+    // assert
+    ASSERT_EQ((std::vector<std::string>{"root/item11", "root/item2/item4", "root/item2/item5", "root/item2/item7", "root/item9/1/item10", "root/item9/1/list2"}), unusedValues[0]);
+    ASSERT_EQ(unusedValues[0], unusedValues[1]);
+}
+
+TEST(OverlayFactoryTests, ShouldGetFactoryEntriesInBaseOrderWithOverwrites) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "zeta: {value: 1}" << std::endl;
+    yaml << "alpha: {value: 2}" << std::endl;
+    yaml << "mid: {value: 3}" << std::endl;
+    auto base = std::make_shared<YamlParser>(yaml.str());
+    auto overlay = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"alpha", "{value: 20}"}, {"mid::value", "30"}, {"added", "{value: 4}"}});
+
+    // act
+    auto entries = overlay->GetFactoryEntries();
+
+    // assert
+    std::vector<std::string> keys;
+    std::vector<int> values;
+    for (const auto& [key, childFactory] : entries) {
+        keys.push_back(key);
+        values.push_back(childFactory->GetByName<int>("value"));
+    }
+    ASSERT_EQ((std::vector<std::string>{"zeta", "alpha", "mid", "added"}), keys);
+    ASSERT_EQ((std::vector<int>{1, 20, 30, 4}), values);
+    ASSERT_EQ(base->GetFactory("zeta"), entries[0].second);
+    ASSERT_EQ(overlay->GetFactory("mid"), entries[2].second);
+}
+
+class OverlayMockClass {
+   public:
+    const int value;
+
+    explicit OverlayMockClass(int value) : value(value) {}
+};
+
+TEST(OverlayFactoryTests, ShouldShareInstancesFromUnchangedChildren) {
+    // arrange
+    Registrar<OverlayMockClass>::Register<OverlayMockClass>(true, "OverlayMockClass", "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "value"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "unchanged: !OverlayMockClass" << std::endl;
+    yaml << "  value: 1" << std::endl;
+    yaml << "changed: !OverlayMockClass" << std::endl;
+    yaml << "  value: 2" << std::endl;
+    auto base = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto variant1 = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"changed::value", "3"}});
+    auto variant2 = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"changed::value", "4"}});
+    auto variant3 = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"changed::value", "3"}});
+
+    // assert
+    ASSERT_EQ(variant1->GetByName<OverlayMockClass>("unchanged"), variant2->GetByName<OverlayMockClass>("unchanged"));
+    ASSERT_EQ(base->GetByName<OverlayMockClass>("unchanged"), variant1->GetByName<OverlayMockClass>("unchanged"));
+    ASSERT_EQ(3, variant1->GetByName<OverlayMockClass>("changed")->value);
+    ASSERT_EQ(4, variant2->GetByName<OverlayMockClass>("changed")->value);
+    ASSERT_EQ(2, base->GetByName<OverlayMockClass>("changed")->value);
+    ASSERT_NE(variant1->GetByName<OverlayMockClass>("changed"), variant3->GetByName<OverlayMockClass>("changed"));
+    ASSERT_TRUE(variant1->GetFactory("changed")->SameFactory(*variant3->GetFactory("changed")));
+    ASSERT_FALSE(variant1->GetFactory("changed")->SameFactory(*variant2->GetFactory("changed")));
+}
+
+TEST(OverlayFactoryTests, ShouldReleaseChangedInstancesWithTheVariant) {
+    // arrange
+    Registrar<OverlayMockClass>::Register<OverlayMockClass>(true, "OverlayMockClass", "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "value"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "unchanged: !OverlayMockClass" << std::endl;
+    yaml << "  value: 1" << std::endl;
+    yaml << "changed: !OverlayMockClass" << std::endl;
+    yaml << "  value: 2" << std::endl;
+    yaml << "replaced: !OverlayMockClass" << std::endl;
+    yaml << "  value: 3" << std::endl;
+    auto base = std::make_shared<YamlParser>(yaml.str());
+    auto variant = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"changed::value", "4"}, {"replaced", "!OverlayMockClass {value: 5}"}});
+
+    // act
+    std::weak_ptr<OverlayMockClass> changedInstance = variant->GetByName<OverlayMockClass>("changed");
+    std::weak_ptr<OverlayMockClass> replacedInstance = variant->GetByName<OverlayMockClass>("replaced");
+    std::weak_ptr<OverlayMockClass> unchangedInstance = variant->GetByName<OverlayMockClass>("unchanged");
+    auto changedWhileAlive = variant->GetByName<OverlayMockClass>("changed") == changedInstance.lock();
+    auto replacedWhileAlive = variant->GetByName<OverlayMockClass>("replaced") == replacedInstance.lock();
+    variant.reset();
+
+    // assert
+    ASSERT_TRUE(changedWhileAlive);
+    ASSERT_TRUE(replacedWhileAlive);
+    ASSERT_TRUE(changedInstance.expired());
+    ASSERT_TRUE(replacedInstance.expired());
+    ASSERT_FALSE(unchangedInstance.expired());
+    ASSERT_EQ(base->GetByName<OverlayMockClass>("unchanged"), unchangedInstance.lock());
+}
+
+TEST(OverlayFactoryTests, ShouldReportUnusedValuesPerVariant) {
+    // arrange
+    auto base = std::make_shared<YamlParser>(OverlayTestDocument());
+    auto variant1 = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"item2::item3", "33"}});
+    auto variant2 = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"item2::item3", "34"}});
+
+    // act
+    variant1->GetByName<int>("item1");
+    variant1->GetFactory("item11")->GetByName<int>("a");
+    auto unused1 = variant1->GetUnusedValues();
+    auto unused2 = variant2->GetUnusedValues();
+    std::sort(unused1.begin(), unused1.end());
+    std::sort(unused2.begin(), unused2.end());
+
+    // assert
+    ASSERT_EQ((std::vector<std::string>{"root/item11/b", "root/item2", "root/item9"}), unused1);
+    ASSERT_EQ((std::vector<std::string>{"root/item1", "root/item11", "root/item2", "root/item9"}), unused2);
+}
+
+TEST(OverlayFactoryTests, ShouldThrowForMalformedSequenceIndexes) {
+    // arrange
+    auto base = std::make_shared<YamlParser>(OverlayTestDocument());
+    auto variant = std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"item9::[x]::list1", "11"}});
+
+    // act
+    // assert
+    ASSERT_THROW(variant->GetFactorySequence("item9"), std::invalid_argument);
+    try {
+        variant->GetFactorySequence("item9");
+    } catch (const std::invalid_argument& exception) {
+        ASSERT_EQ(std::string("unable to overwrite item root/item9/[x], [x] is not a sequence index"), exception.what());
+    }
+    ASSERT_THROW(OverlayFactory(base, std::map<std::string, std::string>({{"item2", "{item4: [1]}"}, {"item2::item4::[-1]", "2"}})), std::invalid_argument);
+    ASSERT_THROW(OverlayFactory(base, std::map<std::string, std::string>({{"item2", "{item4: [1]}"}, {"item2::item4::[3000000000]", "2"}})), std::invalid_argument);
+    ASSERT_THROW(std::make_shared<OverlayFactory>(base, std::map<std::string, std::string>{{"item9::[3000000000]::list1", "11"}})->GetFactorySequence("item9"), std::invalid_argument);
+}
+
+}  // namespace cppParserTesting
@@ -0,0 +1,109 @@
+#include <map>
+#include <sstream>
+#include "gtest/gtest.h"
+#include "overwritePaths.hpp"
+#include "yamlParser.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+/**
+ * Replace one value at a time by loading it as yaml, the reference for the batched overwrites
+ */
+static void ReplaceValue(YAML::Node& yamlConfiguration, const std::string& key, const std::string& value) {
+    auto separator = key.find("::");
+    if (separator == std::string::npos) {
+        yamlConfiguration[key] = YAML::Load(value);
+    } else {
+        auto thisKey = key.substr(0, separator);
+        if (!thisKey.empty() && thisKey[0] == '[' && thisKey.back() == ']') {
+            auto childConfig = yamlConfiguration[std::stoi(thisKey.substr(1, thisKey.size() - 2))];
+            ReplaceValue(childConfig, key.substr(separator + 2), value);
+        } else {
+            auto childConfig = yamlConfiguration[thisKey];
+            ReplaceValue(childConfig, key.substr(separator + 2), value);
+        }
+    }
+}
+
+static std::string OverwriteTestDocument() {
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "item1: 22" << std::endl;
+    yaml << "item2:" << std::endl;
+    yaml << "  item3: 3" << std::endl;
+    yaml << "  item4: [1]" << std::endl;
+    yaml << "  item5: " << std::endl;
+    yaml << "    item6: {} " << std::endl;
+    yaml << "item9: " << std::endl;
+    yaml << "  - list1: 1" << std::endl;
+    yaml << "  - list2:" << std::endl;
+    yaml << "    item10: 10" << std::endl;
+    yaml << "item11: !tagged" << std::endl;
+    yaml << "  a: 1" << std::endl;
+    return yaml.str();
+}
+
+TEST(OverwritePathsTests, ShouldMatchSequentialReplacement) {
+    // arrange
+    auto params = std::map<std::string, std::string>{
+        {"item1", "44"},
+        {"item2", "{item3: 33, item5: {item6: {}}}"},
+        {"item2::item4", "[3, 2]"},
+        {"item2::item5::item6::item7", "77"},
+        {"item9::[1]::item10", "100"},
+        {"item9::[0]::list1", "~"},
+        {"item9::[0]::list3", "null"},
+        {"item9::[0]::list4", ""},
+        {"item11::a", "-1.5e3"},
+        {"item11::b", "!other {c: 3}"},
+        {"item11::d", "'quoted'"},
+        {"item11::e", "- 1"},
+        {"item11::f", "a: b"},
+        {"item11::g", "true"},
+        {"item11::h", "0x10"},
+        {"item11::i", "some/path.yaml"},
+        {"item12::item13::item14", "-"},
+        {"item12::item15", "#comment"},
+    };
+    auto expected = YAML::Load(OverwriteTestDocument());
+    for (const auto& [key, value] : params) {
+        ReplaceValue(expected, key, value);
+    }
+
+    // act
+    auto document = YAML::Load(OverwriteTestDocument());
+    OverwritePaths(params).Apply(document);
+
+    // assert
+    std::stringstream expectedOutput;
+    expectedOutput << expected;
+    std::stringstream output;
+    output << document;
+    ASSERT_EQ(expectedOutput.str(), output.str());
+    ASSERT_EQ(YamlParser(expected).GetHash(), YamlParser(document).GetHash());
+}
+
+class OverwritePathsValueTestFixture : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(OverwritePathsValueTestFixture, ShouldParseValueLikeYaml) {
+    // arrange
+    auto expected = YAML::Load(GetParam());
+
+    // act
+    auto node = OverwritePaths::ParseValue(GetParam());
+
+    // assert
+    ASSERT_EQ(expected.Type(), node.Type());
+    ASSERT_EQ(expected.Tag(), node.Tag());
+    if (expected.IsScalar()) {
+        ASSERT_EQ(expected.Scalar(), node.Scalar());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(OverwritePathsTests, OverwritePathsValueTestFixture,
+                         ::testing::Values("44", "-1.5e3", "+2", ".5", "-.5", "0x10", "true", "word", "some/path.yaml", "a_b-c", "~", "null", "Null", "NULL", "", "-", "--", "- 1",
+                                           "'quoted'", "\"quoted\"", "!tag value", "[1, 2]", "{a: 1}", "a: b", "#comment", "1 # comment", "&anchor 1", "value with spaces"));
+
+}  // namespace cppParserTesting
@@ -30,7 +30,8 @@ class MockClass1 : public MockInterface {
 TEST(RegistrarTests, ShouldRegisterClassAndRecordInLog) {
     // arrange
     auto mockListing = std::make_shared<MockListing>();
-    EXPECT_CALL(*mockListing, RecordListing(Listing::ClassEntry{.interface = Demangler::Demangle<MockInterface>(), .className = "mockClass1", .description = "this is a simple mock class"}))
+    EXPECT_CALL(*mockListing,
+                RecordListing(Listing::ClassEntry{.interface = std::string(Demangler::Demangle<MockInterface>()), .className = "mockClass1", .description = "this is a simple mock class"}))
         .Times(::testing::Exactly(1));
 
     Listing::ReplaceListing(mockListing);
@@ -56,12 +57,12 @@ TEST(RegistrarTests, ShouldRegisterClassWithArgumentIdentifiersAndRecordInLog) {
     auto mockListing = std::make_shared<MockListing>();
     EXPECT_CALL(*mockListing,
                 RecordListing(Listing::ClassEntry{
-                    .interface = Demangler::Demangle<MockInterface>(),
+                    .interface = std::string(Demangler::Demangle<MockInterface>()),
                     .className = "MockClass2",
                     .description = "this is a simple mock class",
-                    .arguments = {Listing::ArgumentEntry{.name = "dog", .interface = Demangler::Demangle<std::string>(), .description = "this is a string"},
-                                  Listing::ArgumentEntry{.name = "cat", .interface = Demangler::Demangle<int>(), .description = "this is a int"},
-                                  Listing::ArgumentEntry{.name = "bird", .interface = Demangler::Demangle<MockInterface>(), .description = "this is a shared pointer to an interface"}}}))
+                    .arguments = {Listing::ArgumentEntry{.name = "dog", .interface = std::string(Demangler::Demangle<std::string>()), .description = "this is a string"},
+                                  Listing::ArgumentEntry{.name = "cat", .interface = std::string(Demangler::Demangle<int>()), .description = "this is a int"},
+                                  Listing::ArgumentEntry{.name = "bird", .interface = std::string(Demangler::Demangle<MockInterface>()), .description = "this is a shared pointer to an interface"}}}))
         .Times(::testing::Exactly(1));
 
     Listing::ReplaceListing(mockListing);
@@ -88,12 +89,13 @@ TEST(RegistrarTests, ShouldRegisterClassWithArgumentIdentifiersAndOptAndRecordIn
     EXPECT_CALL(
         *mockListing,
         RecordListing(Listing::ClassEntry{
-            .interface = Demangler::Demangle<MockInterface>(),
+            .interface = std::string(Demangler::Demangle<MockInterface>()),
             .className = "MockClass2a",
             .description = "this is a simple mock class",
-            .arguments = {Listing::ArgumentEntry{.name = "dog", .interface = Demangler::Demangle<std::string>(), .description = "this is a string", .optional = true},
-                          Listing::ArgumentEntry{.name = "cat", .interface = Demangler::Demangle<int>(), .description = "this is a int", .optional = true},
-                          Listing::ArgumentEntry{.name = "bird", .interface = Demangler::Demangle<MockInterface>(), .description = "this is a shared pointer to an interface", .optional = true}}}))
+            .arguments = {Listing::ArgumentEntry{.name = "dog", .interface = std::string(Demangler::Demangle<std::string>()), .description = "this is a string", .optional = true},
+                          Listing::ArgumentEntry{.name = "cat", .interface = std::string(Demangler::Demangle<int>()), .description = "this is a int", .optional = true},
+                          Listing::ArgumentEntry{
+                              .name = "bird", .interface = std::string(Demangler::Demangle<MockInterface>()), .description = "this is a shared pointer to an interface", .optional = true}}}))
         .Times(::testing::Exactly(1));
 
     Listing::ReplaceListing(mockListing);
@@ -130,12 +132,12 @@ TEST(RegistrarTests, ShouldRegisterDefaultClassWithArgumentIdentifiersAndRecordI
     auto mockListing = std::make_shared<MockListing>();
     EXPECT_CALL(*mockListing,
                 RecordListing(Listing::ClassEntry{
-                    .interface = Demangler::Demangle<MockInterface4>(),
+                    .interface = std::string(Demangler::Demangle<MockInterface4>()),
                     .className = "MockClass4",
                     .description = "this is a simple mock class",
-                    .arguments = {Listing::ArgumentEntry{.name = "dog", .interface = Demangler::Demangle<std::string>(), .description = "this is a string"},
-                                  Listing::ArgumentEntry{.name = "cat", .interface = Demangler::Demangle<int>(), .description = "this is a int"},
-                                  Listing::ArgumentEntry{.name = "bird", .interface = Demangler::Demangle<MockInterface4>(), .description = "this is a shared pointer to an interface"}},
+                    .arguments = {Listing::ArgumentEntry{.name = "dog", .interface = std::string(Demangler::Demangle<std::string>()), .description = "this is a string"},
+                                  Listing::ArgumentEntry{.name = "cat", .interface = std::string(Demangler::Demangle<int>()), .description = "this is a int"},
+                                  Listing::ArgumentEntry{.name = "bird", .interface = std::string(Demangler::Demangle<MockInterface4>()), .description = "this is a shared pointer to an interface"}},
                     .defaultConstructor = true}))
         .Times(::testing::Exactly(1));
 
@@ -242,7 +244,8 @@ static std::shared_ptr<MockClass6> MakeMockClass6Function(std::shared_ptr<Factor
 TEST(RegistrarTests, ShouldRegisterFunctionForClassAndRecordInLog) {
     // arrange
     auto mockListing = std::make_shared<MockListing>();
-    EXPECT_CALL(*mockListing, RecordListing(Listing::ClassEntry{.interface = Demangler::Demangle<MockInterface>(), .className = "mockClass6", .description = "this is a simple mock class"}))
+    EXPECT_CALL(*mockListing,
+                RecordListing(Listing::ClassEntry{.interface = std::string(Demangler::Demangle<MockInterface>()), .className = "mockClass6", .description = "this is a simple mock class"}))
         .Times(::testing::Exactly(1));
 
     Listing::ReplaceListing(mockListing);
@@ -265,7 +268,7 @@ class MockChildClass : public MockParentClass {};
 TEST(RegistrarTests, ShouldRegisterDerivedAndRecordInLog) {
     // arrange
     auto mockListing = std::make_shared<MockListing>();
-    EXPECT_CALL(*mockListing, RecordListing(Listing::DerivedEntry{.interface = Demangler::Demangle<MockParentClass>(), .className = "mockChildClass"})).Times(::testing::Exactly(1));
+    EXPECT_CALL(*mockListing, RecordListing(Listing::DerivedEntry{.interface = std::string(Demangler::Demangle<MockParentClass>()), .className = "mockChildClass"})).Times(::testing::Exactly(1));
 
     Listing::ReplaceListing(mockListing);
 
@@ -276,4 +279,142 @@ TEST(RegistrarTests, ShouldRegisterDerivedAndRecordInLog) {
     Listing::ReplaceListing(nullptr);
 }
 
+class MockParentInterface7 {
+   public:
+    virtual ~MockParentInterface7() = default;
+};
+
+class MockChildInterface7 : public MockParentInterface7 {};
+
+class MockClass7 : public MockChildInterface7 {};
+
+TEST(RegistrarTests, ShouldInvalidateCachedCreateMethodsWhenRegistering) {
+    // arrange
+    // cache a miss for the class and the default
+    ASSERT_TRUE(Creator<MockParentInterface7>::GetCreateMethod("mockClass7") == nullptr);
+    ASSERT_TRUE(Creator<MockParentInterface7>::GetCreateMethod("") == nullptr);
+
+    // act
+    Registrar<MockChildInterface7>::Register<MockClass7>(true, "mockClass7", "this is a simple mock class");
+    Registrar<MockParentInterface7>::RegisterDerived<MockChildInterface7>(true, "mockChildInterface7");
+
+    // assert
+    auto createMethod = Creator<MockParentInterface7>::GetCreateMethod("mockClass7");
+    ASSERT_TRUE(createMethod != nullptr);
+    ASSERT_TRUE(std::dynamic_pointer_cast<MockClass7>(createMethod(nullptr)) != nullptr);
+    ASSERT_TRUE(Creator<MockParentInterface7>::GetCreateMethod("") != nullptr);
+
+    // the cached result should be returned for the same name
+    ASSERT_TRUE(Creator<MockParentInterface7>::GetCreateMethod("mockClass7") != nullptr);
+    ASSERT_TRUE(Creator<MockParentInterface7>::GetCreateMethod("unknownMockClass7") == nullptr);
+}
+
+class MockInterface8 {
+   public:
+    virtual ~MockInterface8() = default;
+};
+
+class MockClass8 : public MockInterface8 {};
+
+TEST(RegistrarTests, ShouldRebuildFrozenRegistrationsWhenRegisteringAfterFreeze) {
+    // arrange
+    for (int i = 0; i < 50; i++) {
+        Registrar<MockInterface8>::Register<MockClass8>(i == 0, "mockClass8_" + std::to_string(i), "this is a simple mock class");
+    }
+    FreezeRegistrations();
+    auto frozenCreateMethod = Creator<MockInterface8>::GetFrozenCreateMethod("mockClass8_10");
+
+    // act
+    Registrar<MockInterface8>::Register<MockClass8>(false, "mockClass8_late", "this is a simple mock class");
+
+    // assert
+    ASSERT_TRUE(frozenCreateMethod != nullptr);
+    for (int i = 0; i < 50; i++) {
+        ASSERT_TRUE(Creator<MockInterface8>::GetFrozenCreateMethod("mockClass8_" + std::to_string(i)) != nullptr);
+    }
+    ASSERT_TRUE(Creator<MockInterface8>::GetFrozenCreateMethod("mockClass8_late") != nullptr);
+    ASSERT_TRUE(Creator<MockInterface8>::GetFrozenCreateMethod("") != nullptr);
+    ASSERT_TRUE(Creator<MockInterface8>::GetFrozenCreateMethod("mockClass8_unknown") == nullptr);
+
+    // repeated lookups use the same frozen entry
+    ASSERT_EQ(Creator<MockInterface8>::GetFrozenCreateMethod("mockClass8_late"), Creator<MockInterface8>::GetFrozenCreateMethod("mockClass8_late"));
+}
+
+class MockInterface10 {
+   public:
+    virtual ~MockInterface10() = default;
+};
+
+class MockClass10 : public MockInterface10 {};
+
+TEST(RegistrarTests, ShouldOnlyRebuildFrozenRegistrationsOfTheRegisteredInterface) {
+    // arrange
+    Registrar<MockInterface10>::Register<MockClass10>(false, "mockClass10", "this is a simple mock class");
+    std::weak_ptr<const Creator<MockInterface10>::TCreateMethod> frozenCreateMethod = Creator<MockInterface10>::GetFrozenCreateMethod("mockClass10");
+
+    // act
+    Registrar<MockInterface8>::Register<MockClass8>(false, "mockClass8_other", "this is a simple mock class");
+    auto sameFrozenCreateMethod = Creator<MockInterface10>::GetFrozenCreateMethod("mockClass10");
+
+    // assert
+    ASSERT_FALSE(frozenCreateMethod.expired());
+    ASSERT_EQ(frozenCreateMethod.lock(), sameFrozenCreateMethod);
+}
+
+TEST(RegistrarTests, ShouldReleaseFrozenRegistrationsOnceRebuilt) {
+    // arrange
+    Registrar<MockInterface10>::Register<MockClass10>(false, "mockClass10_first", "this is a simple mock class");
+    std::weak_ptr<const Creator<MockInterface10>::TCreateMethod> frozenCreateMethod = Creator<MockInterface10>::GetFrozenCreateMethod("mockClass10_first");
+
+    // act
+    Registrar<MockInterface10>::Register<MockClass10>(false, "mockClass10_late", "this is a simple mock class");
+    auto rebuiltCreateMethod = Creator<MockInterface10>::GetFrozenCreateMethod("mockClass10_first");
+
+    // assert
+    ASSERT_TRUE(frozenCreateMethod.expired());
+    ASSERT_TRUE(rebuiltCreateMethod != nullptr);
+    ASSERT_TRUE(Creator<MockInterface10>::GetFrozenCreateMethod("mockClass10_late") != nullptr);
+}
+
+class MockInterface9 {
+   public:
+    virtual ~MockInterface9() = default;
+};
+
+class MockDerivedInterface9 : public MockInterface9 {};
+
+class MockClass9 : public MockInterface9 {
+   public:
+    MockClass9(int){};
+};
+
+TEST(RegistrarTests, ShouldDeferListingUntilRead) {
+    // arrange
+    Listing::Get();
+    Listing::ReplaceListing(nullptr);
+    auto mockListing = std::make_shared<MockListing>();
+    EXPECT_CALL(*mockListing, RecordListing(testing::An<Listing::ClassEntry>())).Times(0);
+    EXPECT_CALL(*mockListing, RecordListing(testing::An<Listing::DerivedEntry>())).Times(0);
+
+    // act
+    Registrar<MockInterface9>::Register<MockClass9>(false, "mockClass9", "this is a simple mock class", ArgumentIdentifier<int>{"cat", "this is a int"});
+    Registrar<MockInterface9>::RegisterDerived<MockDerivedInterface9>(false, "mockDerived9");
+    Listing::ReplaceListing(mockListing);
+
+    // assert
+    testing::Mock::VerifyAndClearExpectations(mockListing.get());
+    EXPECT_CALL(*mockListing,
+                RecordListing(Listing::ClassEntry{.interface = std::string(Demangler::Demangle<MockInterface9>()),
+                                                  .className = "mockClass9",
+                                                  .description = "this is a simple mock class",
+                                                  .arguments = {Listing::ArgumentEntry{.name = "cat", .interface = std::string(Demangler::Demangle<int>()), .description = "this is a int"}}}))
+        .Times(1);
+    EXPECT_CALL(*mockListing, RecordListing(Listing::DerivedEntry{.interface = std::string(Demangler::Demangle<MockInterface9>()), .className = "mockDerived9"})).Times(1);
+    Listing::Get();
+    testing::Mock::VerifyAndClearExpectations(mockListing.get());
+
+    // cleanup
+    Listing::ReplaceListing(nullptr);
+}
+
 }  // namespace cppParserTesting
\ No newline at end of file
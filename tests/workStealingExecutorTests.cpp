@@ -0,0 +1,72 @@
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include "gtest/gtest.h"
+#include "workStealingExecutor.hpp"
+
+namespace cppParserTesting {
+
+using namespace cppParser;
+
+TEST(WorkStealingExecutorTests, ShouldRunAllTasks) {
+    // arrange
+    WorkStealingExecutor executor(4);
+    std::vector<int> results(1000, 0);
+    std::vector<std::function<void()>> tasks;
+    for (std::size_t i = 0; i < results.size(); i++) {
+        tasks.emplace_back([&results, i]() { results[i] = (int)i; });
+    }
+
+    // act
+    executor.Run(std::move(tasks));
+
+    // assert
+    for (std::size_t i = 0; i < results.size(); i++) {
+        ASSERT_EQ(i, results[i]);
+    }
+}
+
+TEST(WorkStealingExecutorTests, ShouldRunNestedTasks) {
+    // arrange
+    WorkStealingExecutor executor(2);
+    std::atomic<int> count = 0;
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < 10; i++) {
+        tasks.emplace_back([&executor, &count]() {
+            // each task waits on its own tasks, which must not starve the pool
+            std::vector<std::function<void()>> nestedTasks;
+            for (int j = 0; j < 10; j++) {
+                nestedTasks.emplace_back([&count]() { count++; });
+            }
+            executor.Run(std::move(nestedTasks));
+        });
+    }
+
+    // act
+    executor.Run(std::move(tasks));
+
+    // assert
+    ASSERT_EQ(100, count);
+}
+
+TEST(WorkStealingExecutorTests, ShouldRethrowExceptionAfterAllTasksComplete) {
+    // arrange
+    WorkStealingExecutor executor(4);
+    std::atomic<int> count = 0;
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < 100; i++) {
+        tasks.emplace_back([&count, i]() {
+            if (i == 50) {
+                throw std::invalid_argument("task failed");
+            }
+            count++;
+        });
+    }
+
+    // act
+    // assert
+    ASSERT_THROW(executor.Run(std::move(tasks)), std::invalid_argument);
+    ASSERT_EQ(99, count);
+}
+
+}  // namespace cppParserTesting
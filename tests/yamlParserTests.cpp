@@ -1,6 +1,7 @@
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include "gtest/gtest.h"
 #include "registrar.hpp"
 #include "yamlParser.hpp"
@@ -592,6 +593,60 @@ TEST(YamlParserTests, ShouldLocateLocalPath) {
     fs::remove(tempYaml);
 }
 
+TEST(YamlParserTests, ShouldViewArrayFiles) {
+    // arrange
+    fs::path testDirectory = fs::temp_directory_path() / "ShouldViewArrayFiles";
+    fs::create_directories(testDirectory / "data");
+    const std::vector<double> coefficients = {1.5, -2.25, 3e10};
+    const std::vector<int> indices = {4, 5, 6};
+    {
+        std::ofstream ofs(testDirectory / "data" / "coeffs.f64", std::ios::binary);
+        ofs.write(reinterpret_cast<const char*>(coefficients.data()), coefficients.size() * sizeof(double));
+    }
+    {
+        std::ofstream ofs(testDirectory / "data" / "indices.i32", std::ios::binary);
+        ofs.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(int));
+    }
+    {
+        std::ofstream ofs(testDirectory / "arrays.yaml");
+        ofs << "---" << std::endl;
+        ofs << "coefficients: !array data/coeffs.f64" << std::endl;
+        ofs << "indices: !array data/indices.i32" << std::endl;
+        ofs << "child:" << std::endl;
+        ofs << "  sameCoefficients: !array data/coeffs.f64" << std::endl;
+        ofs << "  inline: [1, 2.5]" << std::endl;
+        ofs << "  badSize: !array data/indices.i32" << std::endl;
+        ofs << "  missing: !array data/missing.f64" << std::endl;
+    }
+    auto yamlParser = std::make_shared<YamlParser>(testDirectory / "arrays.yaml");
+
+    // act
+    auto coefficientsView = yamlParser->Get(ArgumentIdentifier<ArrayView<double>>{"coefficients"});
+    auto indicesView = yamlParser->Get(ArgumentIdentifier<ArrayView<int>>{"indices"});
+    auto childFactory = yamlParser->GetFactory("child");
+    auto sameCoefficientsView = childFactory->Get(ArgumentIdentifier<ArrayView<double>>{"sameCoefficients"});
+    auto inlineView = childFactory->Get(ArgumentIdentifier<ArrayView<double>>{"inline"});
+    std::span<const double> coefficientsSpan = coefficientsView;
+
+    // assert
+    ASSERT_EQ(coefficients, std::vector<double>(coefficientsView.begin(), coefficientsView.end()));
+    ASSERT_EQ(indices, std::vector<int>(indicesView.begin(), indicesView.end()));
+    ASSERT_EQ(coefficientsView.data(), sameCoefficientsView.data());
+    ASSERT_EQ(coefficientsView.data(), coefficientsSpan.data());
+    ASSERT_EQ(3, coefficientsSpan.size());
+    ASSERT_EQ((std::vector<double>{1, 2.5}), std::vector<double>(inlineView.begin(), inlineView.end()));
+    ASSERT_THROW(childFactory->Get(ArgumentIdentifier<ArrayView<double>>{"badSize"}), std::invalid_argument);
+    ASSERT_THROW(childFactory->Get(ArgumentIdentifier<ArrayView<double>>{"missing"}), std::invalid_argument);
+
+    // the views keep the mapped files alive
+    yamlParser.reset();
+    childFactory.reset();
+    ASSERT_EQ(-2.25, coefficientsView[1]);
+
+    // cleanup
+    fs::remove_all(testDirectory);
+}
+
 TEST(YamlParserTests, ShouldLocateLocalRelativePath) {
     // arrange
     fs::path testDirectory = fs::temp_directory_path() / "ShouldLocateLocalRelativePath";
@@ -938,6 +993,68 @@ TEST(YamlParserTests, ShouldCompareFactories) {
     ASSERT_TRUE(*factory4 == *factory4);
 }
 
+TEST(YamlParserTests, ShouldHashFactoriesByStructure) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " item1: " << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << " item2: " << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << " item3: &anchor1" << std::endl;
+    yaml << "   subItem1: 2.0" << std::endl;
+    yaml << " item4: *anchor1" << std::endl;
+    yaml << " item5: !tagged" << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto factory1 = yamlParser->GetFactory("item1");
+    auto factory2 = yamlParser->GetFactory("item2");
+    auto factory3 = yamlParser->GetFactory("item3");
+    auto factory4 = yamlParser->GetFactory("item4");
+    auto factory5 = yamlParser->GetFactory("item5");
+
+    // assert
+    ASSERT_EQ(factory1->GetHash(), factory2->GetHash());
+    ASSERT_NE(factory1->GetHash(), factory3->GetHash());
+    ASSERT_EQ(factory3->GetHash(), factory4->GetHash());
+    ASSERT_NE(factory1->GetHash(), factory5->GetHash());
+
+    // the same structure does not make the same factory
+    ASSERT_FALSE(*factory1 == *factory2);
+    ASSERT_TRUE(*factory3 == *factory4);
+}
+
+TEST(YamlParserTests, ShouldHashFromChildFactoriesTheSameAsFromTheNodes) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " item1: &anchor1" << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << "   subItem2: [1, 2]" << std::endl;
+    yaml << " item2: !tagged" << std::endl;
+    yaml << "   subItem1: 2.0" << std::endl;
+    yaml << " list:" << std::endl;
+    yaml << "   - subItem1: 3.0" << std::endl;
+    yaml << "   - !ref item2" << std::endl;
+    yaml << "   - *anchor1" << std::endl;
+    auto expectedHash = YamlParser(yaml.str()).GetHash();
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto item1Hash = yamlParser->GetFactory("item1")->GetFactory("subItem1")->GetHash();
+    auto item2Hash = yamlParser->GetFactory("item2")->GetHash();
+    auto listHash = yamlParser->GetFactorySequence("list").front()->GetHash();
+    auto hash = yamlParser->GetHash();
+
+    // assert
+    ASSERT_EQ(expectedHash, hash);
+    ASSERT_NE(item1Hash, item2Hash);
+    ASSERT_NE(item2Hash, listHash);
+}
+
 class YamlMockClass1 {};
 
 TEST(YamlParserTests, ShouldReuseInstances) {
@@ -1174,6 +1291,262 @@ TEST(YamlParserTests, ShouldReportSingleInstanceOfUnusedChildrenWhenUsingAnchors
     ASSERT_EQ("root/item1/testInt2", unusedValues[1]);
 }
 
+TEST(YamlParserTests, ShouldShareHashesOfAliasedNodes) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " item1: &anchor" << std::endl;
+    yaml << "   testInt: 1" << std::endl;
+    yaml << " item2: *anchor" << std::endl;
+    yaml << " item3:" << std::endl;
+    yaml << "   testInt: 1" << std::endl;
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto item1 = yamlParser->GetFactory("item1");
+    auto item2 = yamlParser->GetFactory("item2");
+    auto item3 = yamlParser->GetFactory("item3");
+
+    // assert
+    ASSERT_EQ(item1->GetHash(), item2->GetHash());
+    ASSERT_EQ(item1->GetHash(), item3->GetHash());
+    ASSERT_TRUE(*item1 == *item2);
+    ASSERT_FALSE(*item1 == *item3);
+}
+
+TEST(YamlParserTests, ShouldResolveRefTagsToTheReferencedFactory) {
+    // arrange
+    cppParser::Registrar<YamlMockClass2>::Register<YamlMockClass2>(true, std::string("YamlMockClass1"), "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "testInt"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " solvers:" << std::endl;
+    yaml << "   main:" << std::endl;
+    yaml << "     testInt: 3" << std::endl;
+    yaml << "   other:" << std::endl;
+    yaml << "     testInt: 4" << std::endl;
+    yaml << " list:" << std::endl;
+    yaml << "   - testInt: 5" << std::endl;
+    yaml << "   - testInt: 6" << std::endl;
+    yaml << " solver: !ref solvers/main" << std::endl;
+    yaml << " refs:" << std::endl;
+    yaml << "   - !ref /solvers/other" << std::endl;
+    yaml << "   - !ref list/1" << std::endl;
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto solver = yamlParser->GetByName<YamlMockClass2>("solver");
+    auto refs = yamlParser->GetByName<std::vector<YamlMockClass2>>("refs");
+    auto main = yamlParser->GetFactory("solvers")->GetByName<YamlMockClass2>("main");
+    auto list = yamlParser->GetByName<std::vector<YamlMockClass2>>("list");
+
+    // assert
+    ASSERT_EQ(yamlParser->GetFactory("solvers")->GetFactory("main"), yamlParser->GetFactory("solver"));
+    ASSERT_EQ(main, solver);
+    ASSERT_EQ(3, solver->testInt);
+    ASSERT_EQ(2, refs.size());
+    ASSERT_EQ(4, refs[0]->testInt);
+    ASSERT_EQ(list[1], refs[1]);
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
+TEST(YamlParserTests, ShouldThrowForInvalidRefTags) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " circular1: !ref circular2" << std::endl;
+    yaml << " circular2: !ref circular1" << std::endl;
+    yaml << " missing: !ref not/there" << std::endl;
+    yaml << " list: [1]" << std::endl;
+    yaml << " outOfRange: !ref list/1" << std::endl;
+    yaml << " notAnIndex: !ref list/first" << std::endl;
+    yaml << " tooLong: !ref list/123456789012345678901234567890" << std::endl;
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    // assert
+    ASSERT_THROW(yamlParser->GetFactory("circular1"), std::invalid_argument);
+    ASSERT_THROW(yamlParser->GetFactory("missing"), std::invalid_argument);
+    ASSERT_THROW(yamlParser->GetFactory("outOfRange"), std::invalid_argument);
+    ASSERT_THROW(yamlParser->GetFactory("notAnIndex"), std::invalid_argument);
+    ASSERT_THROW(yamlParser->GetFactory("tooLong"), std::invalid_argument);
+}
+
+TEST(YamlParserTests, ShouldThrowForRefTagsResolvedAfterTheRootIsDestroyed) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " main:" << std::endl;
+    yaml << "   testInt: 3" << std::endl;
+    yaml << " holder:" << std::endl;
+    yaml << "   solver: !ref main" << std::endl;
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+    auto holder = yamlParser->GetFactory("holder");
+
+    // act
+    yamlParser.reset();
+
+    // assert
+    ASSERT_THROW(holder->GetFactory("solver"), std::invalid_argument);
+}
+
+TEST(YamlParserTests, ShouldReportUnusedValuesInSequencesWithFullPaths) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "item1:" << std::endl;
+    yaml << "  list:" << std::endl;
+    yaml << "    - {used: 1, unused: 2}" << std::endl;
+    yaml << "    - {used: 1}" << std::endl;
+    yaml << "    - {used: 1, unused: 3}" << std::endl;
+    yaml << "  list2:" << std::endl;
+    yaml << "    - {used: 1, unused: 2}" << std::endl;
+    yaml << "  listA: [{unused: 1}]" << std::endl;
+    yaml << "item2: 2" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+    auto item1 = yamlParser->GetFactory("item1");
+
+    // act
+    for (const auto& list : {"listA", "list2", "list"}) {
+        for (const auto& element : item1->GetFactorySequence(list)) {
+            if (element->Contains("used")) {
+                element->GetByName<int>("used");
+            }
+        }
+    }
+
+    // assert
+    ASSERT_EQ((std::vector<std::string>{"root/item2", "root/item1/list/0/unused", "root/item1/list/2/unused", "root/item1/list2/0/unused", "root/item1/listA/0/unused"}),
+              yamlParser->GetUnusedValues());
+    ASSERT_EQ(item1->GetFactorySequence("list")[2], item1->GetFactorySequence("list")[2]);
+    try {
+        item1->GetFactorySequence("list")[2]->GetByName<int>("missing");
+        FAIL() << "expected std::invalid_argument";
+    } catch (std::invalid_argument& exception) {
+        ASSERT_EQ(std::string("unable to locate missing in root/item1/list/2"), exception.what());
+    }
+}
+
+TEST(YamlParserTests, ShouldReportUnusedKeysAsWrittenByYaml) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "plain: 1" << std::endl;
+    yaml << "'null': 2" << std::endl;
+    yaml << "\"a: b\": 3" << std::endl;
+    yaml << "dash-key: 4" << std::endl;
+    yaml << "? [1, 2]" << std::endl;
+    yaml << ": 5" << std::endl;
+    yaml << "used: 6" << std::endl;
+    yaml << "used: 7" << std::endl;
+    yaml << "list: [1, 2]" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    yamlParser->GetByName<int>("used");
+    yamlParser->GetFactorySequence("list");
+
+    // assert
+    ASSERT_EQ((std::vector<std::string>{"root/\"a: b\"", "root/\"null\"", "root/[1, 2]", "root/dash-key", "root/plain"}), yamlParser->GetUnusedValues());
+}
+
+TEST(YamlParserTests, ShouldNotReportUnusedValuesWhenUsageIsNotTracked) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "item1: 1" << std::endl;
+    yaml << "item2:" << std::endl;
+    yaml << "  item3: 3" << std::endl;
+    yaml << "  item4: 4" << std::endl;
+    yaml << "item5: [{item6: 6}]" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.trackUsage = false});
+
+    // act
+    auto item3 = yamlParser->GetFactory("item2")->GetByName<int>("item3");
+    auto item5 = yamlParser->GetFactorySequence("item5");
+
+    // assert
+    ASSERT_EQ(3, item3);
+    ASSERT_EQ(6, item5[0]->GetByName<int>("item6"));
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
+TEST(YamlParserTests, ShouldTryGetValuesWithoutThrowing) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "int: 22" << std::endl;
+    yaml << "string: [a, b]" << std::endl;
+    yaml << "empty: ~" << std::endl;
+    yaml << "matrix: [[1, 2], [3, 4]]" << std::endl;
+    yaml << "list: [{int: 1}, {int: 2}]" << std::endl;
+    yaml << "child:" << std::endl;
+    yaml << "  int: 3" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    // assert
+    ASSERT_EQ(22, yamlParser->TryGet(ArgumentIdentifier<int>{.inputName = "int"}));
+    ASSERT_EQ("a b ", yamlParser->TryGet(ArgumentIdentifier<std::string>{.inputName = "string"}));
+    ASSERT_EQ((Matrix<int>(2, 2, {1, 2, 3, 4})), yamlParser->TryGet(ArgumentIdentifier<Matrix<int>>{.inputName = "matrix"}));
+    ASSERT_FALSE(yamlParser->TryGet(ArgumentIdentifier<int>{.inputName = "missing"}).has_value());
+    ASSERT_FALSE(yamlParser->TryGet(ArgumentIdentifier<double>{.inputName = "empty"}).has_value());
+    ASSERT_FALSE(yamlParser->TryGet(ArgumentIdentifier<std::filesystem::path>{.inputName = "missing"}).has_value());
+    ASSERT_EQ(3, yamlParser->TryGetFactory("child")->GetByName<int>("int"));
+    ASSERT_EQ(yamlParser->GetFactory("child"), yamlParser->TryGetFactory("child"));
+    ASSERT_EQ(nullptr, yamlParser->TryGetFactory("missing"));
+    ASSERT_EQ(nullptr, yamlParser->TryGetFactory("empty"));
+    ASSERT_EQ(2, yamlParser->TryGetFactorySequence("list")->size());
+    ASSERT_EQ(yamlParser->GetFactorySequence("list"), yamlParser->TryGetFactorySequence("list"));
+    ASSERT_FALSE(yamlParser->TryGetFactorySequence("missing").has_value());
+    ASSERT_THROW(yamlParser->TryGetFactorySequence("child"), std::invalid_argument);
+    ASSERT_EQ((std::vector<std::string>{"root/empty", "root/list/0/int", "root/list/1/int"}), yamlParser->GetUnusedValues());
+}
+
+class YamlOptionalArgumentsMockClass {
+   public:
+    const int value;
+    const std::shared_ptr<YamlMockClass2> child;
+    const std::vector<std::shared_ptr<YamlMockClass2>> children;
+
+    YamlOptionalArgumentsMockClass(int value, std::shared_ptr<YamlMockClass2> child, std::vector<std::shared_ptr<YamlMockClass2>> children)
+        : value(value), child(std::move(child)), children(std::move(children)) {}
+};
+
+TEST(YamlParserTests, ShouldCreateClassWithMissingOptionalArguments) {
+    // arrange
+    cppParser::Registrar<YamlMockClass2>::Register<YamlMockClass2>(true, std::string("YamlMockClass1"), "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "testInt"});
+    cppParser::Registrar<YamlOptionalArgumentsMockClass>::Register<YamlOptionalArgumentsMockClass>(true, "YamlOptionalArgumentsMockClass", "a class with optional arguments",
+                                                                                                   OPT(int, "value", "an optional int"), OPT(YamlMockClass2, "child", "an optional child"),
+                                                                                                   OPT(std::vector<YamlMockClass2>, "children", "optional children"));
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << "none: {}" << std::endl;
+    yaml << "all:" << std::endl;
+    yaml << "  value: 3" << std::endl;
+    yaml << "  child: {testInt: 4}" << std::endl;
+    yaml << "  children: [{testInt: 5}]" << std::endl;
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto none = yamlParser->GetByName<YamlOptionalArgumentsMockClass>("none");
+    auto all = yamlParser->GetByName<YamlOptionalArgumentsMockClass>("all");
+
+    // assert
+    ASSERT_EQ(0, none->value);
+    ASSERT_EQ(nullptr, none->child);
+    ASSERT_TRUE(none->children.empty());
+    ASSERT_EQ(3, all->value);
+    ASSERT_NE(nullptr, all->child);
+    ASSERT_EQ(1, all->children.size());
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
 TEST(YamlParserTests, ShouldReturnVectorOfVectorsOfInts) {
     // arrange
     std::stringstream yaml;
@@ -1218,6 +1591,48 @@ TEST(YamlParserTests, ShouldReturnVectorOfVectorsOfDouble) {
     ASSERT_EQ(vectorOfVectors, expectedValues);
 }
 
+TEST(YamlParserTests, ShouldReturnMatrix) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " doubles:" << std::endl;
+    yaml << "   - [1, 2.3, 3]" << std::endl;
+    yaml << "   - [4, 5.5, 6]" << std::endl;
+    yaml << " strings: [[a, b], [c, d], [e, f]]" << std::endl;
+    yaml << " empty: []" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto doubles = yamlParser->Get(ArgumentIdentifier<Matrix<double>>{"doubles"});
+    auto strings = yamlParser->Get(ArgumentIdentifier<Matrix<std::string>>{"strings"});
+    auto empty = yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"empty"});
+    auto missing = yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"missing", "", true});
+
+    // assert
+    ASSERT_EQ(Matrix<double>(2, 3, {1, 2.3, 3, 4, 5.5, 6}), doubles);
+    ASSERT_EQ(2.3, doubles(0, 1));
+    ASSERT_EQ(5.5, doubles.Row(1)[1]);
+    ASSERT_EQ(Matrix<std::string>({{"a", "b"}, {"c", "d"}, {"e", "f"}}), strings);
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(0, empty.Rows());
+    ASSERT_TRUE(missing.empty());
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
+TEST(YamlParserTests, ShouldThrowForNonRectangularMatrix) {
+    // arrange
+    auto yamlParser = std::make_shared<YamlParser>(std::string("{ragged: [[1, 2], [3]], long: [[1], [2, 3]], scalarRow: [[1], 2], scalar: 1}"));
+
+    // act
+    // assert
+    ASSERT_THROW(yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"ragged"}), std::invalid_argument);
+    ASSERT_THROW(yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"long"}), std::invalid_argument);
+    ASSERT_THROW(yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"scalarRow"}), std::invalid_argument);
+    ASSERT_THROW(yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"scalar"}), std::invalid_argument);
+    ASSERT_THROW(yamlParser->Get(ArgumentIdentifier<Matrix<int>>{"missing"}), std::invalid_argument);
+}
+
 TEST(YamlParserTests, ShouldReturnVectorOfVectorsOfString) {
     // arrange
     std::stringstream yaml;
@@ -1240,4 +1655,293 @@ TEST(YamlParserTests, ShouldReturnVectorOfVectorsOfString) {
     ASSERT_EQ(vectorOfVectors, expectedValues);
 }
 
-}  // namespace cppParserTesting
\ No newline at end of file
+TEST(YamlParserTests, ShouldLocateValuesInLargeMaps) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    for (int i = 0; i < 100; i++) {
+        yaml << " item" << i << ": " << i << std::endl;
+    }
+    yaml << " child: !classType123" << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    // assert
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(i, yamlParser->Get(ArgumentIdentifier<int>{.inputName = "item" + std::to_string(i)}));
+        ASSERT_TRUE(yamlParser->Contains("item" + std::to_string(i)));
+    }
+    ASSERT_FALSE(yamlParser->Contains("item100"));
+    ASSERT_THROW(yamlParser->Get(ArgumentIdentifier<int>{.inputName = "item100"}), std::invalid_argument);
+    ASSERT_EQ(0, yamlParser->Get(ArgumentIdentifier<int>{.inputName = "item100", .optional = true}));
+    ASSERT_EQ("classType123", yamlParser->GetFactory("child")->GetClassType());
+    ASSERT_EQ(1.0, yamlParser->GetFactory("child")->Get(ArgumentIdentifier<double>{.inputName = "subItem1"}));
+}
+
+TEST(YamlParserTests, ShouldAllowConcurrentAccessWhenThreadSafe) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    for (int i = 0; i < 50; i++) {
+        yaml << " item" << i << ": " << i << std::endl;
+    }
+    yaml << " list:" << std::endl;
+    for (int i = 0; i < 50; i++) {
+        yaml << "   - !classType" << i << std::endl;
+        yaml << "     value: " << i << std::endl;
+    }
+    yaml << " unused: 1" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.threadSafe = true});
+
+    // act
+    const int numberOfThreads = 8;
+    std::vector<std::vector<std::shared_ptr<Factory>>> sequences(numberOfThreads);
+    std::vector<int> sums(numberOfThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numberOfThreads; t++) {
+        threads.emplace_back([&yamlParser, &sequences, &sums, t]() {
+            for (int i = 0; i < 50; i++) {
+                sums[t] += yamlParser->Get(ArgumentIdentifier<int>{.inputName = "item" + std::to_string(i)});
+            }
+            sequences[t] = yamlParser->GetFactorySequence("list");
+            for (const auto& child : sequences[t]) {
+                sums[t] += child->Get(ArgumentIdentifier<int>{.inputName = "value"});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // assert
+    for (int t = 0; t < numberOfThreads; t++) {
+        ASSERT_EQ(2 * 1225, sums[t]);
+        ASSERT_EQ(50, sequences[t].size());
+        for (std::size_t i = 0; i < sequences[t].size(); i++) {
+            // every thread must get the same child factory
+            ASSERT_EQ(sequences[0][i], sequences[t][i]);
+            ASSERT_EQ("classType" + std::to_string(i), sequences[t][i]->GetClassType());
+        }
+    }
+    ASSERT_EQ(std::vector<std::string>{"root/unused"}, yamlParser->GetUnusedValues());
+}
+
+TEST(YamlParserTests, ShouldCreateSequencesAndMapsInParallel) {
+    // arrange
+    cppParser::Registrar<YamlMockClass2>::Register<YamlMockClass2>(true, std::string("YamlMockClass1"), "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "testInt"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " shared: &anchor" << std::endl;
+    yaml << "   testInt: -1" << std::endl;
+    yaml << " list:" << std::endl;
+    for (int i = 0; i < 100; i++) {
+        if (i % 10 == 0) {
+            yaml << "   - *anchor" << std::endl;
+        } else {
+            yaml << "   - testInt: " << i << std::endl;
+        }
+    }
+    yaml << " map:" << std::endl;
+    for (int i = 0; i < 100; i++) {
+        if (i % 10 == 0) {
+            yaml << "   item" << i << ": *anchor" << std::endl;
+        } else {
+            yaml << "   item" << i << ":" << std::endl;
+            yaml << "     testInt: " << i << std::endl;
+        }
+    }
+
+    auto yamlParser = std::make_shared<YamlParser>(
+        yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.parallel = true, .executor = std::make_shared<WorkStealingExecutor>(4)});
+
+    // act
+    auto list = yamlParser->GetByName<std::vector<YamlMockClass2>>("list");
+    auto map = yamlParser->GetByName<std::map<std::string, YamlMockClass2>>("map");
+    auto shared = yamlParser->GetByName<YamlMockClass2>("shared");
+
+    // assert
+    ASSERT_EQ(100, list.size());
+    ASSERT_EQ(100, map.size());
+    for (int i = 0; i < 100; i++) {
+        auto& mapItem = map["item" + std::to_string(i)];
+        if (i % 10 == 0) {
+            // every anchored item must be the same instance
+            ASSERT_EQ(shared, list[i]);
+            ASSERT_EQ(shared, mapItem);
+        } else {
+            ASSERT_EQ(i, list[i]->testInt);
+            ASSERT_EQ(i, mapItem->testInt);
+        }
+    }
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
+TEST(YamlParserTests, ShouldGetOrderedMapInDocumentOrder) {
+    // arrange
+    cppParser::Registrar<YamlMockClass2>::Register<YamlMockClass2>(true, std::string("YamlMockClass1"), "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "testInt"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " map:" << std::endl;
+    yaml << "   zeta:" << std::endl;
+    yaml << "     testInt: 1" << std::endl;
+    yaml << "   alpha:" << std::endl;
+    yaml << "     testInt: 2" << std::endl;
+    yaml << "   zeta:" << std::endl;
+    yaml << "     testInt: 3" << std::endl;
+    yaml << "   mid:" << std::endl;
+    yaml << "     testInt: 4" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str());
+
+    // act
+    auto orderedMap = yamlParser->GetByName<OrderedMap<std::string, YamlMockClass2>>("map");
+    auto map = yamlParser->GetByName<std::map<std::string, YamlMockClass2>>("map");
+    auto missing = yamlParser->Get(ArgumentIdentifier<OrderedMap<std::string, YamlMockClass2>>{.inputName = "missing", .optional = true});
+
+    // assert
+    std::vector<std::pair<std::string, int>> values;
+    for (const auto& [key, instance] : orderedMap) {
+        values.emplace_back(key, instance->testInt);
+    }
+    // duplicate keys resolve to the first entry like a single lookup
+    ASSERT_EQ((std::vector<std::pair<std::string, int>>{{"zeta", 1}, {"alpha", 2}, {"mid", 4}}), values);
+    ASSERT_EQ(3, map.size());
+    ASSERT_EQ(orderedMap.at("alpha"), map["alpha"]);
+    ASSERT_EQ(orderedMap.at("zeta"), map["zeta"]);
+    ASSERT_TRUE(missing.empty());
+    ASSERT_TRUE(yamlParser->GetUnusedValues().empty());
+}
+
+TEST(YamlParserTests, ShouldReportErrorsWhenCreatingInParallel) {
+    // arrange
+    cppParser::Registrar<YamlMockClass2>::Register<YamlMockClass2>(true, std::string("YamlMockClass1"), "this is a simple mock class", ArgumentIdentifier<int>{.inputName = "testInt"});
+
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " list:" << std::endl;
+    yaml << "   - testInt: 1" << std::endl;
+    yaml << "   - !unknownType" << std::endl;
+    yaml << "     testInt: 2" << std::endl;
+
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.parallel = true});
+
+    // act
+    // assert
+    ASSERT_THROW(yamlParser->GetByName<std::vector<YamlMockClass2>>("list"), std::invalid_argument);
+}
+
+TEST(YamlParserTests, ShouldOnlyParseUsedEntriesWhenLazy) {
+    // arrange
+    std::stringstream yaml;
+    yaml << "---" << std::endl;
+    yaml << " item: !redClassType" << std::endl;
+    yaml << "   subItem1: 1.0" << std::endl;
+    yaml << "   subItem2: [1, 2]" << std::endl;
+    yaml << "   nested:" << std::endl;
+    yaml << "     value: 3" << std::endl;
+    yaml << "   broken: [1, 2" << std::endl;
+    yaml << " list:" << std::endl;
+    yaml << " - a" << std::endl;
+    yaml << " - b" << std::endl;
+    yaml << " table: {unterminated: [1, 2, 3" << std::endl;
+
+    // act
+    auto yamlParser = std::make_shared<YamlParser>(yaml.str(), std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.lazy = true});
+    auto item = yamlParser->GetFactory("item");
+
+    // assert
+    ASSERT_THROW(std::make_shared<YamlParser>(yaml.str()), YAML::ParserException);
+    ASSERT_EQ("redClassType", item->GetClassType());
+    ASSERT_EQ(1.0, item->Get(ArgumentIdentifier<double>{"subItem1"}));
+    ASSERT_EQ((std::vector<int>{1, 2}), item->Get(ArgumentIdentifier<std::vector<int>>{"subItem2"}));
+    ASSERT_EQ(3, item->GetFactory("nested")->Get(ArgumentIdentifier<int>{"value"}));
+    ASSERT_EQ((std::vector<std::string>{"a", "b"}), yamlParser->Get(ArgumentIdentifier<std::vector<std::string>>{"list"}));
+    ASSERT_THROW(item->Get(ArgumentIdentifier<std::vector<int>>{"broken"}), YAML::ParserException);
+    ASSERT_EQ((std::unordered_set<std::string>{"item", "list", "table"}), yamlParser->GetKeys());
+}
+
+TEST(YamlParserTests, ShouldMatchFullParseWhenLazy) {
+    // arrange
+    std::vector<std::string> documents = {
+        "item: value\nint: 1\nempty:\nnested:\n  deeper: !tag\n    a: 1 # comment\n\n    b: |\n      text\n      more\n  c: [1,\n    2]\nlist:\n- 1\n- x: 2\n  y: 3\n",
+        "---\n item1: &anchor1\n   subItem1: 2.0\n item2: *anchor1\n",
+        "- not\n- a\n- mapping\n",
+        "key: value\n---\nsecond: document\n"};
+
+    for (const auto& document : documents) {
+        // act
+        auto fullParser = std::make_shared<YamlParser>(document);
+        auto lazyParser = std::make_shared<YamlParser>(document, std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.lazy = true});
+
+        // assert
+        std::stringstream fullOutput, lazyOutput;
+        fullParser->Print(fullOutput);
+        lazyParser->Print(lazyOutput);
+        ASSERT_EQ(fullOutput.str(), lazyOutput.str()) << document;
+        ASSERT_EQ(fullParser->GetHash(), lazyParser->GetHash()) << document;
+    }
+}
+
+TEST(YamlParserTests, ShouldTrackUnusedValuesWhenLazyFromFile) {
+    // arrange
+    fs::path tempPath = fs::temp_directory_path() / "lazyTempFile.yaml";
+    std::ofstream ofs(tempPath);
+    ofs << "---" << std::endl;
+    ofs << "item:" << std::endl;
+    ofs << "  used: 1" << std::endl;
+    ofs << "  unused: 2" << std::endl;
+    ofs << "other: 3" << std::endl;
+    ofs.close();
+
+    // act
+    auto yamlParser = std::make_shared<YamlParser>(tempPath, std::map<std::string, std::string>{}, YamlParserOptions{.lazy = true});
+    auto value = yamlParser->GetFactory("item")->Get(ArgumentIdentifier<int>{"used"});
+
+    // assert
+    ASSERT_EQ(1, value);
+    ASSERT_EQ((std::vector<std::string>{"root/other", "root/item/unused"}), yamlParser->GetUnusedValues());
+
+    // cleanup
+    fs::remove(tempPath);
+}
+
+TEST(YamlParserTests, ShouldReportErrorsAtTheSamePositionWhenLazy) {
+    // arrange
+    // each document and the value read from it
+    std::vector<std::pair<std::string, std::function<void(const Factory&)>>> cases = {
+        {"a: 1\nb: |\n    indented\n  less\n", [](const Factory& factory) { factory.GetByName<std::string>("b"); }},
+        {"a:\n  b: 1\n", [](const Factory& factory) { factory.GetByName<std::string>("a"); }},
+        {"item: !tagged\n  b: 1\n", [](const Factory& factory) { factory.GetByName<int>("item"); }},
+        {"# comment\n---\nx: 1\n", [](const Factory& factory) { factory.Get(ArgumentIdentifier<int>{}); }},
+        {"x: 1\n\ny:\n  z: [1, two]\n", [](const Factory& factory) { factory.GetFactory("y")->GetByName<std::vector<int>>("z"); }},
+        {"m:\n  k1: v\n  k2:\n    deep: 1\n", [](const Factory& factory) { factory.GetByName<std::map<std::string, std::string>>("m"); }},
+        {"x: 1\ns:\n  - a\n  - {b: 1}\n", [](const Factory& factory) { factory.GetByName<std::string>("s"); }},
+        {"x: 1\nrows:\n  - [1, 2]\n  - [3, four]\n", [](const Factory& factory) { factory.GetByName<Matrix<int>>("rows"); }},
+    };
+
+    for (const auto& [document, read] : cases) {
+        // act
+        std::string fullError, lazyError;
+        try {
+            read(YamlParser(document));
+        } catch (const YAML::Exception& exception) {
+            fullError = exception.what();
+        }
+        try {
+            read(YamlParser(document, std::vector<std::filesystem::path>{}, std::map<std::string, std::string>{}, YamlParserOptions{.lazy = true}));
+        } catch (const YAML::Exception& exception) {
+            lazyError = exception.what();
+        }
+
+        // assert
+        ASSERT_NE("", fullError) << document;
+        ASSERT_EQ(fullError, lazyError) << document;
+    }
+}
+
+}  // namespace cppParserTesting